@@ -0,0 +1,83 @@
+#include <indicators/progress_bar.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Discards everything, so only the cost of updating the bar is measured
+    class NullBuffer : public std::streambuf
+    {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+    };
+
+    double run(size_t threads, size_t ticks_per_thread, bool sharded)
+    {
+        using namespace indicators;
+
+        NullBuffer buffer;
+        std::ostream null_stream(&buffer);
+        ProgressBar bar{
+            option::MaxProgress{threads * ticks_per_thread},
+            option::MinRedrawInterval{std::chrono::milliseconds(100)},
+            option::ShardedProgress{sharded},
+            option::Stream{null_stream}};
+
+        std::vector<std::thread> workers;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < threads; ++i)
+        {
+            workers.emplace_back([&bar, ticks_per_thread]() {
+                for (size_t j = 0; j < ticks_per_thread; ++j)
+                {
+                    bar.tick();
+                }
+            });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        if (bar.current() != threads * ticks_per_thread || !bar.is_completed())
+        {
+            std::fprintf(stderr, "lost updates: %zu of %zu\n", bar.current(), threads * ticks_per_thread);
+            std::exit(1);
+        }
+        // Wall time per tick of a single thread
+        return double(elapsed.count()) * threads / double(threads * ticks_per_thread);
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    size_t max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+    const size_t ticks_per_thread = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000000;
+    if (max_threads == 0)
+    {
+        max_threads = 1;
+    }
+
+    std::printf("%8s %16s %16s\n", "threads", "atomic ns/tick", "sharded ns/tick");
+    for (size_t threads = 1;; threads *= 2)
+    {
+        if (threads > max_threads)
+        {
+            threads = max_threads;
+        }
+        std::printf("%8zu %16.2f %16.2f\n", threads, run(threads, ticks_per_thread, false), run(threads, ticks_per_thread, true));
+        if (threads == max_threads)
+        {
+            break;
+        }
+    }
+    return 0;
+}
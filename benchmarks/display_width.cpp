@@ -0,0 +1,77 @@
+#include <indicators/display_width.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#if __has_include(<codecvt>)
+#include <codecvt>
+#include <locale>
+#define HAVE_CODECVT 1
+#endif
+
+namespace
+{
+#if HAVE_CODECVT
+    // The display_width() of indicators 1.9: decode to a heap std::wstring through codecvt, then mk_wcswidth()
+    int codecvt_display_width(const std::string &input)
+    {
+        std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+        return unicode::details::mk_wcswidth(converter.from_bytes(input).c_str(), input.size());
+    }
+#endif
+
+    template <typename Function>
+    double measure(const std::string &input, size_t iterations, Function function)
+    {
+        volatile int sink = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            sink = sink + function(input);
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        return double(elapsed.count()) / double(iterations);
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    struct Case
+    {
+        const char *name;
+        std::string text;
+    };
+    const std::vector<Case> cases = {
+        {"ascii prefix", "Downloading "},
+        {"ascii postfix", "[00m:12s<01m:40s] 42/100 chunks"},
+        {"ascii 256", std::string(256, 'x')},
+        {"block glyph", u8"█"},
+        {"cyrillic", u8"Загрузка файла"},
+        {"cjk", u8"进度条测试"},
+        {"mixed", u8"Compiling ✔ main.cpp → main.o (文件)"},
+    };
+
+    std::printf("%-16s %8s %14s %14s\n", "input", "columns", "bytes ns/call", "codecvt ns/call");
+    for (const auto &c : cases)
+    {
+        const int width = unicode::display_width(c.text);
+        const double bytes = measure(c.text, iterations, [](const std::string &s) { return unicode::display_width(s); });
+#if HAVE_CODECVT
+        if (codecvt_display_width(c.text) != width)
+        {
+            std::fprintf(stderr, "%s: width %d, codecvt says %d\n", c.name, width, codecvt_display_width(c.text));
+            return 1;
+        }
+        const double codecvt = measure(c.text, iterations, codecvt_display_width);
+        std::printf("%-16s %8d %14.2f %14.2f\n", c.name, width, bytes, codecvt);
+#else
+        std::printf("%-16s %8d %14.2f %14s\n", c.name, width, bytes, "-");
+#endif
+    }
+    return 0;
+}
\ No newline at end of file
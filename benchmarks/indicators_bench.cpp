@@ -0,0 +1,385 @@
+#include <indicators/block_progress_bar.h>
+#include <indicators/display_width.h>
+#include <indicators/dynamic_progress.h>
+#include <indicators/indeterminate_progress_bar.h>
+#include <indicators/multi_progress.h>
+#include <indicators/progress_bar.h>
+#include <indicators/progress_spinner.h>
+#include <indicators/termcolor.h>
+#include <indicators/terminal_size.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+    Overhead of the indicators, printed as one JSON object:
+      tick           ns per tick() of each indicator, from one thread and from several
+      frame          ns and bytes per frame each indicator renders
+      display_width  unicode::display_width() on ASCII and CJK text
+      container      ns and bytes per frame of MultiProgress and DynamicProgress as bars are added
+
+    Output goes to a stream that counts bytes and flushes instead of a terminal, so
+    the terminal's own cost is left out. Usage: indicators_bench [iterations] [threads]
+*/
+
+namespace
+{
+    using namespace indicators;
+
+    /* Counts bytes, and flushes as frames. Colorized and sized like an 80x200 terminal, so that indicators draw frames. */
+    class FrameCounter : public std::ostream
+    {
+    public:
+        FrameCounter() : std::ostream(nullptr)
+        {
+            rdbuf(&buffer_);
+            *this << termcolor::colorize;
+            pin_terminal_size(*this, 200, 80);
+        }
+
+        ~FrameCounter()
+        {
+            unpin_terminal_size(*this);
+        }
+
+        size_t bytes() const
+        {
+            return buffer_.bytes;
+        }
+
+        size_t frames() const
+        {
+            return buffer_.frames;
+        }
+
+        void reset()
+        {
+            flush();
+            buffer_.bytes = 0;
+            buffer_.frames = 0;
+            buffer_.pending = false;
+        }
+
+    private:
+        class Buffer : public std::streambuf
+        {
+        public:
+            size_t bytes{0};
+            size_t frames{0};
+            bool pending{false};
+
+        protected:
+            int overflow(int c) override
+            {
+                ++bytes;
+                pending = true;
+                return c;
+            }
+
+            std::streamsize xsputn(const char *, std::streamsize n) override
+            {
+                bytes += static_cast<size_t>(n);
+                pending = n > 0 || pending;
+                return n;
+            }
+
+            int sync() override
+            {
+                frames += pending ? 1 : 0;
+                pending = false;
+                return 0;
+            }
+        };
+
+        Buffer buffer_;
+    };
+
+    double nanoseconds_since(std::chrono::steady_clock::time_point start)
+    {
+        return double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    /* Wall time per call of one thread, with `threads` threads calling `tick` `iterations` times each */
+    template <typename Tick>
+    double time_ticks(size_t threads, size_t iterations, Tick tick)
+    {
+        std::vector<std::thread> workers;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < threads; ++i)
+        {
+            workers.emplace_back([&tick, iterations]() {
+                for (size_t j = 0; j < iterations; ++j)
+                {
+                    tick();
+                }
+            });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        return nanoseconds_since(start) / double(iterations);
+    }
+
+    struct Results
+    {
+        std::vector<std::string> tick;
+        std::vector<std::string> frame;
+        std::vector<std::string> display_width;
+        std::vector<std::string> container;
+    };
+
+    std::string format(const char *pattern, ...)
+    {
+        char text[256];
+        va_list args;
+        va_start(args, pattern);
+        std::vsnprintf(text, sizeof(text), pattern, args);
+        va_end(args);
+        return text;
+    }
+
+    /*
+        tick() with a MinRedrawInterval no update reaches, so the cost is the update
+        and the throttle, not the frame
+    */
+    void bench_ticks(Results &results, size_t iterations, size_t threads)
+    {
+        const auto interval = std::chrono::hours(1);
+        const size_t max_progress = iterations * threads + 1;
+        for (size_t t : {size_t(1), threads})
+        {
+            {
+                FrameCounter out;
+                ProgressBar bar{option::MaxProgress{max_progress}, option::Stream{out}, option::MinRedrawInterval{interval}};
+                const auto ns = time_ticks(t, iterations, [&bar]() { bar.tick(); });
+                results.tick.push_back(format("{\"indicator\": \"ProgressBar\", \"threads\": %zu, \"ns_per_tick\": %.2f}", t, ns));
+            }
+            {
+                FrameCounter out;
+                ProgressBar bar{option::MaxProgress{max_progress}, option::Stream{out}, option::MinRedrawInterval{interval}, option::ShardedProgress{true}};
+                const auto ns = time_ticks(t, iterations, [&bar]() { bar.tick(); });
+                results.tick.push_back(format("{\"indicator\": \"ProgressBar sharded\", \"threads\": %zu, \"ns_per_tick\": %.2f}", t, ns));
+            }
+            {
+                FrameCounter out;
+                BlockProgressBar bar{option::MaxProgress{max_progress}, option::Stream{out}, option::MinRedrawInterval{interval}};
+                const auto ns = time_ticks(t, iterations, [&bar]() { bar.tick(); });
+                results.tick.push_back(format("{\"indicator\": \"BlockProgressBar\", \"threads\": %zu, \"ns_per_tick\": %.2f}", t, ns));
+            }
+            {
+                FrameCounter out;
+                IndeterminateProgressBar bar{option::Stream{out}, option::MinRedrawInterval{interval}};
+                const auto ns = time_ticks(t, iterations, [&bar]() { bar.tick(); });
+                results.tick.push_back(format("{\"indicator\": \"IndeterminateProgressBar\", \"threads\": %zu, \"ns_per_tick\": %.2f}", t, ns));
+            }
+            {
+                FrameCounter out;
+                ProgressSpinner spinner{option::MaxProgress{max_progress}, option::Stream{out}, option::MinRedrawInterval{interval}};
+                const auto ns = time_ticks(t, iterations, [&spinner]() { spinner.tick(); });
+                results.tick.push_back(format("{\"indicator\": \"ProgressSpinner\", \"threads\": %zu, \"ns_per_tick\": %.2f}", t, ns));
+            }
+            if (threads == 1)
+            {
+                break;
+            }
+        }
+    }
+
+    /* Every update changes what is shown, so every update renders a frame */
+    template <typename Update>
+    void time_frames(Results &results, const char *name, FrameCounter &out, size_t iterations, Update update)
+    {
+        out.reset();
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            update(i);
+        }
+        const auto ns = nanoseconds_since(start);
+        const auto frames = std::max<size_t>(out.frames(), 1);
+        results.frame.push_back(format("{\"indicator\": \"%s\", \"frames\": %zu, \"ns_per_frame\": %.2f, \"bytes_per_frame\": %.2f}",
+                                       name, out.frames(), ns / double(frames), double(out.bytes()) / double(frames)));
+    }
+
+    void bench_frames(Results &results, size_t iterations)
+    {
+        {
+            FrameCounter out;
+            ProgressBar bar{option::BarWidth{50}, option::PrefixText{"Downloading "}, option::PostfixText{"chunk.bin"},
+                            option::ForegroundColor{Color::green}, option::ShowPercentage{true}, option::ShowElapsedTime{true},
+                            option::ShowRemainingTime{true}, option::MaxProgress{100}, option::Stream{out}};
+            time_frames(results, "ProgressBar", out, iterations, [&bar](size_t i) { bar.set_progress(i % 99); });
+        }
+        {
+            FrameCounter out;
+            BlockProgressBar bar{option::BarWidth{50}, option::PrefixText{"Downloading "}, option::ForegroundColor{Color::green},
+                                 option::ShowPercentage{true}, option::ShowElapsedTime{true}, option::MaxProgress{100}, option::Stream{out}};
+            time_frames(results, "BlockProgressBar", out, iterations, [&bar](size_t i) { bar.set_progress(float(i % 99)); });
+        }
+        {
+            FrameCounter out;
+            IndeterminateProgressBar bar{option::BarWidth{50}, option::PrefixText{"Waiting "}, option::ForegroundColor{Color::yellow},
+                                         option::Stream{out}};
+            time_frames(results, "IndeterminateProgressBar", out, iterations, [&bar](size_t) { bar.tick(); });
+        }
+        {
+            FrameCounter out;
+            ProgressSpinner spinner{option::PostfixText{"Checking credentials"}, option::ForegroundColor{Color::cyan},
+                                    option::MaxProgress{iterations + 1}, option::Stream{out}};
+            time_frames(results, "ProgressSpinner", out, iterations, [&spinner](size_t) { spinner.tick(); });
+        }
+    }
+
+    void bench_display_width(Results &results, size_t iterations)
+    {
+        struct Case
+        {
+            const char *name;
+            std::string text;
+        };
+        std::string cjk;
+        while (cjk.size() < 256)
+        {
+            cjk.append(u8"进度条测试");
+        }
+        const std::vector<Case> cases = {
+            {"ascii 12", "Downloading "},
+            {"ascii 256", std::string(256, 'x')},
+            {"cjk 15", u8"进度条测试"},
+            {"cjk 270", cjk},
+        };
+        for (const auto &c : cases)
+        {
+            volatile int sink = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                sink = sink + unicode::display_width(c.text);
+            }
+            const auto ns = nanoseconds_since(start) / double(iterations);
+            results.display_width.push_back(format("{\"input\": \"%s\", \"bytes\": %zu, \"ns_per_call\": %.2f, \"mb_per_s\": %.2f}",
+                                                   c.name, c.text.size(), ns, double(c.text.size()) * 1e3 / ns));
+        }
+    }
+
+    void record_container(Results &results, const char *name, size_t bars, const char *rows, double ns, const FrameCounter &out)
+    {
+        const auto frames = std::max<size_t>(out.frames(), 1);
+        results.container.push_back(format("{\"container\": \"%s\", \"bars\": %zu, \"rows_changed\": \"%s\", \"frames\": %zu, \"ns_per_frame\": %.2f, \"bytes_per_frame\": %.2f}",
+                                           name, bars, rows, out.frames(), ns / double(frames), double(out.bytes()) / double(frames)));
+    }
+
+    /*
+        "one": every update is drawn, and changes one row.
+        "all": every bar is updated while a frozen clock holds redraws back, then one frame draws all of them.
+    */
+    template <typename Container, typename Bars>
+    void time_container(Results &results, const char *name, Container &container, Bars &bars, FrameCounter &out, size_t iterations)
+    {
+        const size_t count = bars.size();
+        out.reset();
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            bars[i % count].set_progress((i / count) % 999);
+        }
+        record_container(results, name, count, "one", nanoseconds_since(start), out);
+
+        ManualClock clock;
+        container.set_option(option::Clock{&clock});
+        container.set_option(option::MinRedrawInterval{std::chrono::hours(1)});
+        const size_t frames = std::max<size_t>(iterations / count, 1);
+        // The first update after the interval changed is still drawn
+        bars[0].set_progress(0);
+        container.print_progress();
+        out.reset();
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < frames; ++i)
+        {
+            for (auto &bar : bars)
+            {
+                bar.set_progress((i + 1) % 999);
+            }
+            container.print_progress();
+        }
+        record_container(results, name, count, "all", nanoseconds_since(start), out);
+    }
+
+    template <size_t... I>
+    void bench_multi(Results &results, size_t iterations, std::index_sequence<I...>)
+    {
+        FrameCounter out;
+        std::deque<ProgressBar> bars;
+        for (size_t i = 0; i < sizeof...(I); ++i)
+        {
+            bars.emplace_back(option::BarWidth{40}, option::PrefixText{"job " + std::to_string(i) + " "}, option::ShowPercentage{true},
+                              option::MaxProgress{1000}, option::Stream{out});
+        }
+        MultiProgress<ProgressBar, sizeof...(I)> multi(bars[I]...);
+        multi.set_option(option::Stream{out});
+        time_container(results, "MultiProgress", multi, bars, out, iterations);
+    }
+
+    void bench_dynamic(Results &results, size_t iterations, size_t count)
+    {
+        FrameCounter out;
+        std::deque<ProgressBar> bars;
+        DynamicProgress<ProgressBar> dynamic;
+        dynamic.set_option(option::Stream{out});
+        for (size_t i = 0; i < count; ++i)
+        {
+            bars.emplace_back(option::BarWidth{40}, option::PrefixText{"job " + std::to_string(i) + " "}, option::ShowPercentage{true},
+                              option::MaxProgress{1000}, option::Stream{out});
+            dynamic.push_back(bars.back());
+        }
+        time_container(results, "DynamicProgress", dynamic, bars, out, iterations);
+    }
+
+    void print_section(const char *name, const std::vector<std::string> &entries, bool last)
+    {
+        std::printf("  \"%s\": [\n", name);
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            std::printf("    %s%s\n", entries[i].c_str(), i + 1 < entries.size() ? "," : "");
+        }
+        std::printf("  ]%s\n", last ? "" : ",");
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    size_t threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    threads = std::max<size_t>(threads, 1);
+
+    Results results;
+    bench_ticks(results, iterations, threads);
+    bench_frames(results, iterations / 10);
+    bench_display_width(results, iterations);
+    bench_multi(results, iterations / 10, std::make_index_sequence<1>());
+    bench_multi(results, iterations / 10, std::make_index_sequence<8>());
+    bench_multi(results, iterations / 10, std::make_index_sequence<64>());
+    for (size_t count : {size_t(1), size_t(8), size_t(64), size_t(150)})
+    {
+        bench_dynamic(results, iterations / 10, count);
+    }
+
+    std::printf("{\n  \"iterations\": %zu,\n  \"threads\": %zu,\n", iterations, threads);
+    print_section("tick", results.tick, false);
+    print_section("frame", results.frame, false);
+    print_section("display_width", results.display_width, false);
+    print_section("container", results.container, true);
+    std::printf("}\n");
+    return 0;
+}
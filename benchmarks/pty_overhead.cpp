@@ -0,0 +1,226 @@
+#include <indicators/dynamic_progress.h>
+#include <indicators/progress_bar.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#if defined(__APPLE__)
+#include <util.h>
+#else
+#include <pty.h>
+#endif
+
+/*
+    What progress output costs a program whose terminal is slow, e.g. over SSH.
+
+    stdout is a pseudo-terminal whose master side is read no faster than the given
+    rate, so the writes of the indicators block once the kernel buffer is full, as
+    they would on a slow link. Two workloads run with and without indicators:
+      single_bar        one thread ticking a ProgressBar for every iteration
+      dynamic_progress  threads each ticking their own bar of a DynamicProgress
+
+    For each: the slowdown against the run without indicators, the bytes the terminal
+    received, and the longest a worker went without finishing a block of iterations.
+    The report is JSON on the original stdout.
+
+    Indicators use the MinRedrawInterval given, 16 ms unless told otherwise. With 0,
+    every tick of a DynamicProgress row is a frame, and the run is bound by the terminal.
+
+    Usage: pty_overhead [iterations] [threads] [terminal bytes per second] [min redraw interval ms]
+*/
+
+namespace
+{
+    using namespace indicators;
+    using clock_type = std::chrono::steady_clock;
+
+    /* Iterations between two looks at the clock */
+    constexpr size_t block = 1024;
+
+    struct Run
+    {
+        double seconds{0};
+        double worst_stall_ms{0};
+    };
+
+    template <typename Tick>
+    Run run_loop(size_t iterations, Tick tick)
+    {
+        volatile size_t sink = 0;
+        Run run;
+        const auto start = clock_type::now();
+        auto last = start;
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            sink = sink + i;
+            tick();
+            if (i % block == block - 1)
+            {
+                const auto now = clock_type::now();
+                run.worst_stall_ms = std::max(run.worst_stall_ms, std::chrono::duration<double, std::milli>(now - last).count());
+                last = now;
+            }
+        }
+        run.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+        return run;
+    }
+
+    /* Runs `threads` loops at once: the wall time of all of them, and the worst stall of any */
+    template <typename MakeTick>
+    Run run_threads(size_t threads, size_t iterations, MakeTick make_tick)
+    {
+        std::vector<Run> runs(threads);
+        std::vector<std::thread> workers;
+        const auto start = clock_type::now();
+        for (size_t i = 0; i < threads; ++i)
+        {
+            workers.emplace_back([&runs, &make_tick, i, iterations]() { runs[i] = run_loop(iterations, make_tick(i)); });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        Run run;
+        run.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+        for (const auto &r : runs)
+        {
+            run.worst_stall_ms = std::max(run.worst_stall_ms, r.worst_stall_ms);
+        }
+        return run;
+    }
+
+    /* stdout on a fresh 24x80 pseudo-terminal, drained at `bytes_per_second` until finish() */
+    class SlowTerminal
+    {
+    public:
+        explicit SlowTerminal(size_t bytes_per_second) : bytes_per_second_(std::max<size_t>(bytes_per_second, 1))
+        {
+            struct winsize size = {};
+            size.ws_row = 24;
+            size.ws_col = 80;
+            if (openpty(&master_, &slave_, nullptr, nullptr, &size) != 0)
+            {
+                std::perror("openpty");
+                std::exit(1);
+            }
+            reader_ = std::thread([this]() { drain(); });
+            std::cout.flush();
+            std::fflush(stdout);
+            saved_stdout_ = dup(STDOUT_FILENO);
+            dup2(slave_, STDOUT_FILENO);
+        }
+
+        /* Puts stdout back, and returns the bytes the terminal received once it read them all */
+        size_t finish()
+        {
+            std::cout.flush();
+            std::fflush(stdout);
+            dup2(saved_stdout_, STDOUT_FILENO);
+            close(saved_stdout_);
+            close(slave_);
+            reader_.join();
+            close(master_);
+            return bytes_;
+        }
+
+    private:
+        void drain()
+        {
+            // Small reads, so the rate holds over short spans as well
+            std::vector<char> buffer(std::max<size_t>(std::min<size_t>(bytes_per_second_ / 100, 4096), 1));
+            const auto start = clock_type::now();
+            for (;;)
+            {
+                const auto n = read(master_, buffer.data(), buffer.size());
+                if (n <= 0)
+                {
+                    // EIO once the slave side is closed and everything was read
+                    break;
+                }
+                bytes_ += static_cast<size_t>(n);
+                std::this_thread::sleep_until(start + std::chrono::duration_cast<clock_type::duration>(
+                                                          std::chrono::duration<double>(double(bytes_) / double(bytes_per_second_))));
+            }
+        }
+
+        const size_t bytes_per_second_;
+        int master_{-1};
+        int slave_{-1};
+        int saved_stdout_{-1};
+        std::thread reader_;
+        size_t bytes_{0};
+    };
+
+    void print_result(const char *name, size_t threads, size_t iterations, const Run &baseline, const Run &progress, size_t bytes, bool last)
+    {
+        std::printf("  \"%s\": {\"threads\": %zu, \"iterations\": %zu, \"baseline_s\": %.3f, \"progress_s\": %.3f, \"slowdown\": %.2f, "
+                    "\"bytes_written\": %zu, \"baseline_worst_stall_ms\": %.3f, \"worst_stall_ms\": %.3f}%s\n",
+                    name, threads, iterations, baseline.seconds, progress.seconds, progress.seconds / std::max(baseline.seconds, 1e-9),
+                    bytes, baseline.worst_stall_ms, progress.worst_stall_ms, last ? "" : ",");
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+    const size_t threads = std::max<size_t>(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64, 1);
+    const size_t bytes_per_second = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1024 * 1024;
+    const auto min_redraw_interval = std::chrono::milliseconds(argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 16);
+
+    // One bar ticked on every iteration
+    const auto single_baseline = run_loop(iterations, []() {});
+    Run single;
+    size_t single_bytes;
+    {
+        SlowTerminal terminal(bytes_per_second);
+        {
+            ProgressBar bar{option::BarWidth{40}, option::PrefixText{"Processing "}, option::ShowPercentage{true},
+                            option::ShowElapsedTime{true}, option::ShowRemainingTime{true}, option::MaxProgress{iterations},
+                            option::MinRedrawInterval{min_redraw_interval}};
+            single = run_loop(iterations, [&bar]() { bar.tick(); });
+        }
+        single_bytes = terminal.finish();
+    }
+
+    // Every thread ticks its own row of a DynamicProgress
+    const size_t per_thread = std::max<size_t>(iterations / threads, 1);
+    const auto dynamic_baseline = run_threads(threads, per_thread, [](size_t) { return []() {}; });
+    Run dynamic;
+    size_t dynamic_bytes;
+    {
+        SlowTerminal terminal(bytes_per_second);
+        {
+            std::deque<ProgressBar> bars;
+            DynamicProgress<ProgressBar> progress;
+            progress.set_option(option::MinRedrawInterval{min_redraw_interval});
+            for (size_t i = 0; i < threads; ++i)
+            {
+                bars.emplace_back(option::BarWidth{30}, option::PrefixText{"worker " + std::to_string(i) + " "},
+                                  option::ShowPercentage{true}, option::ShowElapsedTime{true}, option::MaxProgress{per_thread});
+                progress.push_back(bars.back());
+            }
+            dynamic = run_threads(threads, per_thread, [&bars](size_t i) {
+                auto *bar = &bars[i];
+                return [bar]() { bar->tick(); };
+            });
+        }
+        dynamic_bytes = terminal.finish();
+    }
+
+    std::printf("{\n  \"terminal\": {\"rows\": 24, \"cols\": 80, \"bytes_per_second\": %zu},\n  \"min_redraw_interval_ms\": %lld,\n",
+                bytes_per_second, static_cast<long long>(min_redraw_interval.count()));
+    print_result("single_bar", 1, iterations, single_baseline, single, single_bytes, false);
+    print_result("dynamic_progress", threads, per_thread * threads, dynamic_baseline, dynamic, dynamic_bytes, true);
+    std::printf("}\n");
+    return 0;
+}
@@ -55,6 +55,15 @@
 #include <indicators/color.h>
 #include <indicators/setting.h>
 #include <indicators/terminal_size.h>
+#include <indicators/details/frame_key.h>
+#include <indicators/details/frame_stream.h>
+#include <indicators/details/json_line.h>
+#include <indicators/details/plain_line.h>
+#include <indicators/details/prometheus_text.h>
+#include <indicators/details/rate_estimator.h>
+#include <indicators/details/redraw_throttle.h>
+#include <indicators/details/row_state.h>
+#include <indicators/details/status_cell.h>
 #include <indicators/details/stream_helper.h>
 
 namespace indicators
@@ -65,7 +74,8 @@ namespace indicators
                                     option::PrefixText, option::PostfixText, option::ShowPercentage,
                                     option::ShowElapsedTime, option::ShowRemainingTime, option::Completed,
                                     option::SavedStartTime, option::MaxPostfixTextLen, option::FontStyles,
-                                    option::MaxProgress, option::Stream>;
+                                    option::MaxProgress, option::Stream, option::MinRedrawInterval,
+                                    option::OutputFormat, option::ShowRate, option::RateUnit, option::Label, option::Clock>;
 
     public:
         template <typename... Args, typename std::enable_if<details::are_settings_from_tuple<Settings, typename std::decay<Args>::type...>::value, void *>::type = nullptr>
@@ -84,7 +94,16 @@ namespace indicators
                         details::get<details::ProgressBarOption::max_postfix_text_len>(option::MaxPostfixTextLen{0}, std::forward<Args>(args)...),
                         details::get<details::ProgressBarOption::font_styles>(option::FontStyles{std::vector<FontStyle>{}}, std::forward<Args>(args)...),
                         details::get<details::ProgressBarOption::max_progress>(option::MaxProgress{100}, std::forward<Args>(args)...),
-                        details::get<details::ProgressBarOption::stream>(option::Stream{std::cout}, std::forward<Args>(args)...)) {}
+                        details::get<details::ProgressBarOption::stream>(option::Stream{std::cout}, std::forward<Args>(args)...),
+                        details::get<details::ProgressBarOption::min_redraw_interval>(option::MinRedrawInterval{std::chrono::nanoseconds::zero()}, std::forward<Args>(args)...),
+                        details::get<details::ProgressBarOption::output_format>(option::OutputFormat{OutputFormat::automatic}, std::forward<Args>(args)...),
+                        details::get<details::ProgressBarOption::show_rate>(option::ShowRate{false}, std::forward<Args>(args)...),
+                        details::get<details::ProgressBarOption::rate_unit>(option::RateUnit{"it"}, std::forward<Args>(args)...),
+                        details::get<details::ProgressBarOption::label>(option::Label{}, std::forward<Args>(args)...),
+                        details::get<details::ProgressBarOption::clock>(option::Clock{&Clock::steady()}, std::forward<Args>(args)...))
+        {
+            on_option_changed();
+        }
 
         template <typename T, details::ProgressBarOption id>
         void set_option(details::Setting<T, id> &&setting)
@@ -92,6 +111,7 @@ namespace indicators
             static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
             std::lock_guard<std::mutex> lock(mutex_);
             get_value<id>() = std::move(setting).value;
+            on_option_changed();
         }
 
         template <typename T, details::ProgressBarOption id>
@@ -100,6 +120,7 @@ namespace indicators
             static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
             std::lock_guard<std::mutex> lock(mutex_);
             get_value<id>() = setting.value;
+            on_option_changed();
         }
 
         void set_option(const details::Setting<std::string, details::ProgressBarOption::postfix_text> &setting);
@@ -134,7 +155,9 @@ namespace indicators
 
         Settings settings_;
         float progress_{0.0};
-        std::chrono::time_point<std::chrono::high_resolution_clock> start_time_point_;
+        std::chrono::nanoseconds start_time_{0};
+        /* Sampled with the elapsed time whenever a frame or line is drawn */
+        details::RateEstimator rate_;
         std::mutex mutex_;
 
         template <typename Indicator, size_t count>
@@ -142,12 +165,91 @@ namespace indicators
         template <typename Indicator>
         friend class DynamicProgress;
         std::atomic<bool> multi_progress_mode_{false};
+        details::RowState row_;
+        /* Elapsed second the row was last drawn at, so the container redraws it when the shown time moves on */
+        long long row_second_{-1};
+
+        /* Snapshots for a StatusServer, published while the bar draws */
+        friend class StatusServer;
+        details::StatusSlot status_;
+
+        /* Frame buffer reused between renders, so a steady-state frame does not allocate */
+        std::string line_;
+        details::StylePrefix style_;
+        details::BlockProgressScaleWriter scale_writer_;
+        size_t prefix_width_{0};
+        size_t postfix_text_width_{0};
+        bool layout_dirty_{true};
+        size_t layout_version_{0};
+        details::RedrawThrottle redraw_throttle_;
+        /* option::Clock, read without the mutex by whoever claims the next frame */
+        std::atomic<const Clock *> clock_{&Clock::steady()};
+
+        std::chrono::nanoseconds now() const { return clock_.load(std::memory_order_acquire)->now(); }
+
+        /* Key of the last frame written, to skip frames that would look the same */
+        details::FrameKey drawn_key_;
+        details::DurationText elapsed_text_;
+        details::DurationText remaining_text_;
+
+        /* OutputFormat with automatic resolved against the stream, whenever the options change */
+        OutputFormat output_format_{OutputFormat::terminal};
+        details::PlainLineSchedule plain_schedule_;
+
+        void on_option_changed();
+
+        void on_progress_changed(bool completing, std::chrono::nanoseconds min_redraw_interval);
 
         void save_start_time();
 
-        std::pair<std::string, size_t> get_prefix_text();
+        void update_layout();
+
+        size_t append_prefix_text(std::string &out);
+
+        /* Time since the start, sampled into the rate estimator */
+        std::chrono::nanoseconds update_elapsed();
+
+        size_t percentage() const;
+
+        std::chrono::nanoseconds remaining_time(std::chrono::nanoseconds elapsed) const;
+
+        details::FrameKey frame_key(std::chrono::nanoseconds elapsed, size_t terminal_width) const;
+
+        size_t append_postfix_text(std::string &out, std::chrono::nanoseconds elapsed);
+
+        void append_json(std::string &out, std::chrono::nanoseconds elapsed);
+
+        void publish_status(std::chrono::nanoseconds elapsed);
+
+        /* Read by a PrometheusExporter on its own thread */
+        friend class PrometheusExporter;
+
+        void collect_metrics(details::BarMetrics &metrics);
+
+        std::chrono::nanoseconds min_redraw_interval() const;
+
+        /* Appends prefix, bar and postfix to line_ and returns their display width */
+        size_t compose_row(std::chrono::nanoseconds elapsed);
+
+        /* OutputFormat::plain_lines: the row without escapes or padding, when its schedule says so */
+        void write_plain_line(std::ostream &os, std::chrono::nanoseconds elapsed, bool final);
+
+        void draw_progress(std::ostream &os, bool from_multi_progress);
+
+        /* Rows of a container's frame are as wide as the terminal the frame goes to, not this bar's stream */
+        void draw_progress(std::ostream &os, bool from_multi_progress, size_t terminal_width);
+
+        /* Draws this bar's row into the frame MultiProgress or DynamicProgress is composing */
+        void print_row(details::FrameStream &frame);
+
+        /* Whether the row has to be drawn again: the bar changed, or the time it shows did */
+        bool take_row_dirty();
+
+        /* Writes this bar's JSON line into the output of a container in OutputFormat::json_lines */
+        void print_json(std::ostream &os);
 
-        std::pair<std::string, size_t> get_postfix_text();
+        /* Writes this bar's plain line into the output of a container in OutputFormat::plain_lines, when due */
+        void print_plain(std::ostream &os);
 
     public:
         void print_progress(bool from_multi_progress = false);
@@ -0,0 +1,84 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Clock
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_CLOCK_H
+#define INDICATORS_CLOCK_H
+
+#include <atomic>
+#include <chrono>
+
+namespace indicators
+{
+    /*
+        Where indicators read the time from: elapsed and remaining time, rates and
+        how often they redraw. Given with option::Clock; by default Clock::steady().
+    */
+    class Clock
+    {
+    public:
+        virtual ~Clock() = default;
+
+        /* Time since an arbitrary epoch that does not change */
+        virtual std::chrono::nanoseconds now() const = 0;
+
+        /* std::chrono::steady_clock, shared by every indicator without a clock of its own */
+        static const Clock &steady();
+    };
+
+    /*
+        Moves only when told to, so that elapsed time, ETA and throttling are the same
+        on every run of a test or benchmark. Can be advanced from any thread.
+    */
+    class ManualClock : public Clock
+    {
+    public:
+        explicit ManualClock(std::chrono::nanoseconds start = std::chrono::nanoseconds::zero());
+
+        std::chrono::nanoseconds now() const override;
+
+        void advance(std::chrono::nanoseconds duration);
+
+        void set(std::chrono::nanoseconds time);
+
+    private:
+        std::atomic<long long> now_ns_;
+    };
+} // namespace indicators
+
+#endif // INDICATORS_CLOCK_H
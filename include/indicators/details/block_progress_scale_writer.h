@@ -41,6 +41,7 @@
 #define INDICATORS_BLOCK_PROGRESS_SCALE_WRITER_H
 
 #include <indicators/display_width.h>
+#include <indicators/details/glyph_run.h>
 #include <indicators/setting.h>
 #include <indicators/termcolor.h>
 
@@ -61,12 +62,23 @@ namespace indicators
         class BlockProgressScaleWriter
         {
         public:
-            BlockProgressScaleWriter(std::ostream &os, size_t bar_width) : os(os), bar_width(bar_width) {}
-            std::ostream &write(float progress);
+            BlockProgressScaleWriter() = default;
+            explicit BlockProgressScaleWriter(size_t bar_width)
+            {
+                set_style(bar_width);
+            }
+
+            /* Compiles a run of full blocks as wide as the bar, so that write() copies a prefix of it */
+            void set_style(size_t bar_width);
+
+            void write(std::string &out, float progress) const;
+
+            /* Eighths of a cell the bar is filled up to at this progress */
+            size_t position(float progress) const;
 
         private:
-            std::ostream &os;
             size_t bar_width = 0;
+            GlyphRun fill;
         };
     } // namespace details
 } // namespace indicators
@@ -0,0 +1,81 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Frame key
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_FRAME_KEY_H
+#define INDICATORS_FRAME_KEY_H
+
+#include <cstddef>
+
+namespace indicators
+{
+    namespace details
+    {
+        /*
+            Everything a determinate bar frame shows, reduced to numbers. Two frames with
+            equal keys render the same line, so the second one is not written. Fields that
+            are not shown stay at their defaults.
+        */
+        struct FrameKey
+        {
+            size_t position = 0;
+            size_t percent = 0;
+            long long elapsed_seconds = -1;
+            long long remaining_seconds = -1;
+            long long rate_tenths = -1;
+            size_t rate_prefix = 0;
+            size_t layout_version = 0;
+            size_t terminal_width = 0;
+        };
+
+        inline bool operator==(const FrameKey &lhs, const FrameKey &rhs)
+        {
+            return lhs.position == rhs.position && lhs.percent == rhs.percent &&
+                   lhs.elapsed_seconds == rhs.elapsed_seconds && lhs.remaining_seconds == rhs.remaining_seconds &&
+                   lhs.rate_tenths == rhs.rate_tenths && lhs.rate_prefix == rhs.rate_prefix &&
+                   lhs.layout_version == rhs.layout_version && lhs.terminal_width == rhs.terminal_width;
+        }
+
+        inline bool operator!=(const FrameKey &lhs, const FrameKey &rhs)
+        {
+            return !(lhs == rhs);
+        }
+    } // namespace details
+} // namespace indicators
+
+#endif // INDICATORS_FRAME_KEY_H
\ No newline at end of file
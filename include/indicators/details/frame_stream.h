@@ -0,0 +1,129 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Frame stream
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_FRAME_STREAM_H
+#define INDICATORS_FRAME_STREAM_H
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+namespace indicators
+{
+    namespace details
+    {
+        class StylePrefix;
+
+        /*
+            An ostream that appends to a string kept between frames. MultiProgress and
+            DynamicProgress compose every row, cursor movement and color of a frame
+            here, then hand it to the terminal with write_frame(). Text can also be
+            appended to str() directly. Every frame starts and ends in the default SGR state.
+        */
+        class FrameStream : public std::ostream
+        {
+        public:
+            FrameStream();
+
+            FrameStream(const FrameStream &) = delete;
+            FrameStream &operator=(const FrameStream &) = delete;
+
+            std::string &str()
+            {
+                return buffer_.text;
+            }
+
+            /* Starts a new frame, colorized only if `target` would be */
+            void reset(std::ostream &target);
+
+            /* Columns of the terminal behind the target of the frame */
+            size_t terminal_width() const
+            {
+                return terminal_width_;
+            }
+
+            /*
+                Switches the text that follows to `style`. The frame tracks the SGR state,
+                so only transitions are written: rows styled like the row above cost nothing.
+            */
+            void set_style(const StylePrefix &style);
+
+            /* Back to the default SGR state, as every frame has to end */
+            void clear_style();
+
+            /*
+                Columns taken by the widest line of the text appended since `offset` of str(),
+                escape sequences aside, to count the terminal lines a row wraps to.
+            */
+            size_t columns_since(size_t offset) const;
+
+        private:
+            class Buffer : public std::streambuf
+            {
+            public:
+                std::string text;
+
+            protected:
+                int_type overflow(int_type ch) override;
+                std::streamsize xsputn(const char *s, std::streamsize n) override;
+            };
+
+            Buffer buffer_;
+            bool colorized_{false};
+            size_t terminal_width_{0};
+            /* SGR parameters in effect at the end of the frame so far */
+            std::string sgr_;
+        };
+
+        /* "\033[<lines>A" and "\033[<lines>B", nothing when lines is 0 */
+        void append_cursor_up(std::string &out, size_t lines);
+        void append_cursor_down(std::string &out, size_t lines);
+
+        /*
+            Writes a composed frame to `os` and flushes it. For std::cout, std::cerr and
+            std::clog the frame goes to the file descriptor in as few write() calls as
+            the kernel accepts, so the terminal never sees half a frame. A standard stream
+            whose rdbuf() was replaced is written through its new buffer.
+        */
+        void write_frame(std::ostream &os, const std::string &frame);
+    } // namespace details
+} // namespace indicators
+
+#endif // INDICATORS_FRAME_STREAM_H
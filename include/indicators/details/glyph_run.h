@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Glyph run
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_GLYPH_RUN_H
+#define INDICATORS_GLYPH_RUN_H
+
+#include <cstddef>
+#include <string>
+
+namespace indicators
+{
+    namespace details
+    {
+        /*
+            A glyph repeated as often as it fits into a number of columns. Any number of
+            glyphs up to that is then appended with a single copy, and the display width
+            of the glyph is only computed once.
+        */
+        class GlyphRun
+        {
+        public:
+            GlyphRun() = default;
+
+            void assign(const std::string &glyph, size_t columns);
+
+            void append(std::string &out, size_t count) const
+            {
+                out.append(run_.data(), count * glyph_size_);
+            }
+
+            const std::string &glyph() const
+            {
+                return glyph_;
+            }
+
+            /* Display width of one glyph */
+            size_t width() const
+            {
+                return width_;
+            }
+
+        private:
+            std::string glyph_;
+            std::string run_;
+            size_t glyph_size_ = 0;
+            size_t width_ = 0;
+        };
+    } // namespace details
+} // namespace indicators
+
+#endif // INDICATORS_GLYPH_RUN_H
\ No newline at end of file
@@ -41,6 +41,7 @@
 #define INDICATORS_INDETERMINATE_PROGRESS_SCALE_WRITER_H
 
 #include <indicators/display_width.h>
+#include <indicators/details/glyph_run.h>
 #include <indicators/setting.h>
 #include <indicators/termcolor.h>
 
@@ -61,16 +62,18 @@ namespace indicators
         class IndeterminateProgressScaleWriter
         {
         public:
-            IndeterminateProgressScaleWriter(std::ostream &os, size_t bar_width, const std::string &fill, const std::string &lead)
-                : os(os), bar_width(bar_width), fill(fill), lead(lead) {}
+            IndeterminateProgressScaleWriter() = default;
 
-            std::ostream &write(size_t progress);
+            /* Compiles the style into a run of fill glyphs, so that write() copies prefixes of it */
+            void set_style(size_t bar_width, const std::string &fill, const std::string &lead);
+
+            void write(std::string &out, size_t progress) const;
 
         private:
-            std::ostream &os;
             size_t bar_width = 0;
-            std::string fill;
+            GlyphRun fill;
             std::string lead;
+            size_t lead_width = 0;
         };
     } // namespace details
 } // namespace indicators
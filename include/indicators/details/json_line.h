@@ -0,0 +1,80 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief JSON line
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_JSON_LINE_H
+#define INDICATORS_JSON_LINE_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace indicators
+{
+    namespace details
+    {
+        /* Appends one compact JSON object, field by field, to a line buffer */
+        class JsonLine
+        {
+        public:
+            explicit JsonLine(std::string &out);
+
+            JsonLine &field(const char *name, const std::string &value);
+            JsonLine &field(const char *name, size_t value);
+            JsonLine &field(const char *name, bool value);
+            /* Fixed point with one decimal */
+            JsonLine &field(const char *name, double value);
+            /* In seconds, with one decimal */
+            JsonLine &field(const char *name, std::chrono::nanoseconds value);
+
+            /* Closes the object and ends the line */
+            void end();
+
+        private:
+            std::string &out_;
+            bool first_{true};
+
+            void key(const char *name);
+        };
+
+        /* Minimum time between two JSON lines: MinRedrawInterval, or one second when it is zero */
+        std::chrono::nanoseconds json_line_interval(std::chrono::nanoseconds min_redraw_interval);
+    } // namespace details
+} // namespace indicators
+
+#endif // INDICATORS_JSON_LINE_H
@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Plain line
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_PLAIN_LINE_H
+#define INDICATORS_PLAIN_LINE_H
+
+#include <indicators/output_format.h>
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace indicators
+{
+    namespace details
+    {
+        /*
+            Resolves OutputFormat::automatic once per stream: terminal frames when the stream is
+            a terminal or was forced to color with termcolor::colorize, plain lines otherwise
+        */
+        OutputFormat resolve_output_format(OutputFormat format, std::ostream &os);
+
+        /* How often updates check whether a plain line is due: MinRedrawInterval, at least 100 ms */
+        std::chrono::nanoseconds plain_line_interval(std::chrono::nanoseconds min_redraw_interval);
+
+        /* Drops the padding a row ends with and ends the line */
+        void end_plain_line(std::string &line);
+
+        /*
+            When OutputFormat::plain_lines writes a line: on the first update, then whenever the
+            percentage crosses a multiple of 10 or 10 seconds passed since the last line, and
+            once more for the final state
+        */
+        class PlainLineSchedule
+        {
+        public:
+            bool due(size_t percent, bool final, std::chrono::nanoseconds now);
+
+        private:
+            std::chrono::nanoseconds written_at_{0};
+            size_t step_{0};
+            bool started_{false};
+            bool finished_{false};
+        };
+    } // namespace details
+} // namespace indicators
+
+#endif // INDICATORS_PLAIN_LINE_H
@@ -41,6 +41,7 @@
 #define INDICATORS_PROGRESS_SCALE_WRITER_H
 
 #include <indicators/display_width.h>
+#include <indicators/details/glyph_run.h>
 #include <indicators/setting.h>
 #include <indicators/termcolor.h>
 
@@ -61,17 +62,22 @@ namespace indicators
         class ProgressScaleWriter
         {
         public:
-            ProgressScaleWriter(std::ostream &os, size_t bar_width, const std::string &fill, const std::string &lead, const std::string &remainder)
-                : os(os), bar_width(bar_width), fill(fill), lead(lead), remainder(remainder) {}
+            ProgressScaleWriter() = default;
 
-            std::ostream &write(float progress);
+            /* Compiles the style into runs of fill and remainder glyphs, so that write() copies prefixes of them */
+            void set_style(size_t bar_width, const std::string &fill, const std::string &lead, const std::string &remainder);
+
+            void write(std::string &out, float progress) const;
+
+            /* Column the bar is filled up to at this progress */
+            size_t position(float progress) const;
 
         private:
-            std::ostream &os;
             size_t bar_width = 0;
-            std::string fill;
+            GlyphRun fill;
             std::string lead;
-            std::string remainder;
+            size_t lead_width = 0;
+            GlyphRun remainder;
         };
     } // namespace details
 } // namespace indicators
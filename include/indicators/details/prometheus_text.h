@@ -0,0 +1,86 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Prometheus text format
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_PROMETHEUS_TEXT_H
+#define INDICATORS_PROMETHEUS_TEXT_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace indicators
+{
+    namespace details
+    {
+        /* What a progress bar exports, read under its mutex like a frame */
+        struct BarMetrics
+        {
+            std::string label;
+            double progress{0};
+            double max_progress{0};
+            /* Units per second, recent */
+            double rate{0};
+            std::chrono::nanoseconds elapsed{0};
+            std::chrono::nanoseconds remaining{0};
+            bool completed{false};
+            /* Without progress, an IndeterminateProgressBar, or without a rate, a spinner, the samples are left out */
+            bool has_progress{true};
+            bool has_rate{true};
+        };
+
+        /* The label of a bar's metrics: option::Label, or else the prefix text without surrounding spaces */
+        std::string metric_label(const std::string &label, const std::string &prefix_text);
+
+        /*
+            Gives every bar a label of its own, as Prometheus rejects two samples with
+            the same labels. A bar without a label becomes "bar", and a label taken by
+            an earlier bar gets the first free suffix "_2", "_3", ...
+        */
+        void make_labels_unique(std::vector<BarMetrics> &bars);
+
+        /*
+            Appends the metrics of all bars in the Prometheus text exposition format,
+            one gauge family after the other, each with a sample per bar labelled
+            bar="<label>".
+        */
+        void append_prometheus(std::string &out, const std::vector<BarMetrics> &bars);
+    } // namespace details
+} // namespace indicators
+
+#endif // INDICATORS_PROMETHEUS_TEXT_H
@@ -0,0 +1,84 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Rate estimator
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_RATE_ESTIMATOR_H
+#define INDICATORS_RATE_ESTIMATOR_H
+
+#include <chrono>
+
+namespace indicators
+{
+    namespace details
+    {
+        /*
+            Throughput of the last few seconds: an exponentially weighted moving average of
+            the rate between samples, each weighted by the time it covers, so a slow warm-up
+            fades out. O(1) per sample. Samples are taken when a frame is drawn.
+        */
+        class RateEstimator
+        {
+        public:
+            /* `work` units done in total after `elapsed` */
+            void sample(double work, std::chrono::nanoseconds elapsed);
+
+            bool has_rate() const
+            {
+                return has_rate_;
+            }
+
+            /* Units per second, 0 until two samples far enough apart were taken */
+            double rate() const
+            {
+                return rate_;
+            }
+
+            /* Time `remaining_work` takes at the current rate, which has to be above zero */
+            std::chrono::nanoseconds remaining(double remaining_work) const;
+
+        private:
+            double last_work_{0};
+            std::chrono::nanoseconds last_elapsed_{0};
+            double rate_{0};
+            bool started_{false};
+            bool has_rate_{false};
+        };
+    } // namespace details
+} // namespace indicators
+
+#endif // INDICATORS_RATE_ESTIMATOR_H
@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Row state
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_ROW_STATE_H
+#define INDICATORS_ROW_STATE_H
+
+#include <atomic>
+
+namespace indicators
+{
+    namespace details
+    {
+        /* Implemented by MultiProgress and DynamicProgress to hear about updates to their rows */
+        class RowListener
+        {
+        public:
+            virtual void row_changed(bool completed) = 0;
+
+        protected:
+            ~RowListener() = default;
+        };
+
+        /*
+            Kept by an indicator drawn as a row of MultiProgress or DynamicProgress. The
+            indicator marks the row dirty on every visible change and the container redraws
+            only dirty rows. A new row starts dirty.
+        */
+        class RowState
+        {
+        public:
+            void attach(RowListener *listener);
+
+            /* Returns once no call to the listener is in flight, so the listener can be destroyed */
+            void detach(RowListener *listener);
+
+            /* Marks the row dirty and tells the container. Not to be called with the indicator's mutex held. */
+            void changed(bool completed);
+
+            /* Marks the row dirty without telling the container, for changes made under the indicator's mutex */
+            void mark_dirty();
+
+            /* Whether the row changed since the last call */
+            bool take_dirty();
+
+        private:
+            std::atomic<bool> dirty_{true};
+            std::atomic<RowListener *> listener_{nullptr};
+            /* Calls to the listener in flight, waited for by detach() */
+            std::atomic<unsigned> calls_{0};
+        };
+    } // namespace details
+} // namespace indicators
+
+#endif // INDICATORS_ROW_STATE_H
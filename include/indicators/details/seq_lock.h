@@ -0,0 +1,117 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Sequence lock
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_SEQ_LOCK_H
+#define INDICATORS_SEQ_LOCK_H
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+namespace indicators
+{
+    namespace details
+    {
+        /*
+            A sequence lock: the version is odd while a writer updates the data it
+            guards, and readers retry when it moved while they read. Readers never
+            make a writer wait. The data itself has to be atomics, read relaxed.
+            A writer whose process died mid-write is taken over by the next one.
+        */
+        class SeqLock
+        {
+        public:
+            /* Claims the lock and returns the version to pass to write_end(). Several writers take turns. */
+            unsigned write_begin();
+
+            void write_end(unsigned version);
+
+            /* Version to read at, odd while a write is in progress */
+            unsigned read_begin() const;
+
+            /* Whether what was read since read_begin() returned `version` is consistent */
+            bool read_valid(unsigned version) const;
+
+        private:
+            std::atomic<unsigned> version_{0};
+            /* Process id of the current writer, 0 when there is none */
+            std::atomic<long long> writer_{0};
+        };
+
+        /* Text of up to capacity - 1 bytes, to be guarded by a SeqLock */
+        template <size_t capacity>
+        class SeqText
+        {
+        public:
+            /* Truncates at a UTF-8 character boundary */
+            void store(const std::string &text)
+            {
+                auto length = text.size() < capacity ? text.size() : capacity - 1;
+                while (length < text.size() && length > 0 && (static_cast<unsigned char>(text[length]) & 0xC0) == 0x80)
+                {
+                    --length;
+                }
+                for (size_t i = 0; i < length; ++i)
+                {
+                    chars_[i].store(text[i], std::memory_order_relaxed);
+                }
+                chars_[length].store('\0', std::memory_order_relaxed);
+            }
+
+            void load(std::string &text) const
+            {
+                text.clear();
+                for (size_t i = 0; i < capacity; ++i)
+                {
+                    const auto c = chars_[i].load(std::memory_order_relaxed);
+                    if (c == '\0')
+                    {
+                        break;
+                    }
+                    text.push_back(c);
+                }
+            }
+
+        private:
+            std::atomic<char> chars_[capacity];
+        };
+    } // namespace details
+} // namespace indicators
+
+#endif // INDICATORS_SEQ_LOCK_H
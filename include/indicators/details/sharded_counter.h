@@ -0,0 +1,97 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Sharded counter
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_SHARDED_COUNTER_H
+#define INDICATORS_SHARDED_COUNTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace indicators
+{
+    namespace details
+    {
+        /*
+            A counter split into cache-line sized slots, one per CPU (or per
+            thread where the CPU number is not available), so that threads
+            updating it concurrently do not bounce a single cache line between
+            cores.
+
+            Like the Linux percpu_counter, every slot flushes into a shared
+            `central` value once it accumulates `batch` units. approximate()
+            therefore costs one load and is never further than error_bound()
+            away from the exact sum(), which visits every slot.
+        */
+        class ShardedCounter
+        {
+        public:
+            static constexpr size_t cache_line_size = 64;
+            static constexpr std::int64_t batch = 1024;
+
+            /* `shards` is rounded up to a power of two; 0 picks one slot per hardware thread */
+            explicit ShardedCounter(size_t shards = 0);
+
+            void add(std::int64_t delta);
+
+            std::int64_t sum() const;
+
+            std::int64_t approximate() const;
+
+            std::int64_t error_bound() const;
+
+            size_t shards() const;
+
+        private:
+            struct alignas(cache_line_size) Slot
+            {
+                std::atomic<std::int64_t> value{0};
+            };
+
+            alignas(cache_line_size) std::atomic<std::int64_t> central_{0};
+            std::unique_ptr<Slot[]> slots_;
+            size_t mask_{0};
+
+            Slot &local_slot();
+        };
+    } // namespace details
+} // namespace indicators
+
+#endif // INDICATORS_SHARDED_COUNTER_H
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Progress bar state shared between processes
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_SHARED_BAR_STATE_H
+#define INDICATORS_SHARED_BAR_STATE_H
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#include <indicators/details/seq_lock.h>
+
+namespace indicators
+{
+    namespace details
+    {
+        /* Identifier of the calling process, cached and refreshed after fork() */
+        long long current_process_id();
+
+        /*
+            The part of a ProgressBar that lives in a SharedProgress segment, one per
+            bar. Workers tick `progress` and report completion and a new postfix; only
+            the owner, the process that created the segment, draws.
+            Everything here is a lock-free atomic, so it works across processes.
+        */
+        struct alignas(64) SharedBarState
+        {
+            static constexpr size_t postfix_capacity = 128;
+
+            std::atomic<size_t> progress;
+            std::atomic<size_t> max_progress;
+            std::atomic<bool> completed;
+            std::atomic<long long> owner;
+
+            /* Its version tells the owner whether a worker changed the postfix */
+            SeqLock postfix_lock;
+            SeqText<postfix_capacity> postfix;
+
+            bool is_owner() const;
+
+            /* Truncated to postfix_capacity - 1 bytes, at a UTF-8 character boundary */
+            void publish_postfix(const std::string &text);
+
+            /* Copies the postfix into `text` if it changed since `seen_version`, and updates it */
+            bool read_postfix(unsigned &seen_version, std::string &text) const;
+        };
+    } // namespace details
+} // namespace indicators
+
+#endif // INDICATORS_SHARED_BAR_STATE_H
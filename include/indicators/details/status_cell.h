@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Status snapshots of an indicator
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_STATUS_CELL_H
+#define INDICATORS_STATUS_CELL_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <indicators/details/seq_lock.h>
+
+namespace indicators
+{
+    namespace details
+    {
+        /*
+            The latest JSON snapshot of an indicator. The indicator publishes it
+            while it draws, and a StatusServer reads it from its own thread without
+            ever taking the indicator's mutex.
+        */
+        class StatusCell
+        {
+        public:
+            static constexpr size_t capacity = 1024;
+
+            /* A snapshot that does not fit goes to a heap buffer behind a mutex, held only to copy it */
+            void publish(const std::string &json);
+
+            /* Retries while a publish is in progress. False until the first one. */
+            bool read(std::string &json) const;
+
+        private:
+            SeqLock lock_;
+            SeqText<capacity> text_;
+            mutable std::mutex overflow_mutex_;
+            std::string overflow_;
+        };
+
+        /* Implemented by StatusServer, to hear about rows pushed to a DynamicProgress it reports */
+        class StatusBoard
+        {
+        public:
+            virtual void add_cell(StatusCell &cell) = 0;
+
+        protected:
+            ~StatusBoard() = default;
+        };
+
+        /*
+            Kept by an indicator. The cell is only created once a StatusServer reports
+            the indicator, so until then publishing costs nothing. Used with the
+            indicator's mutex held.
+        */
+        class StatusSlot
+        {
+        public:
+            StatusCell &cell();
+
+            /* Whether a StatusServer reports the indicator, so it has to publish */
+            bool enabled() const;
+
+            /* Where to compose the snapshot before publish() */
+            std::string &buffer();
+
+            void publish();
+
+        private:
+            std::unique_ptr<StatusCell> cell_;
+            std::string buffer_;
+        };
+    } // namespace details
+} // namespace indicators
+
+#endif // INDICATORS_STATUS_CELL_H
@@ -65,6 +65,56 @@ namespace indicators
         void set_stream_color(std::ostream &os, Color color);
         void set_font_style(std::ostream &os, FontStyle style);
         std::ostream &write_duration(std::ostream &os, std::chrono::nanoseconds ns);
+
+        /* Append-only counterparts of the stream helpers, used to compose a frame without allocating */
+        void append_number(std::string &out, size_t value, size_t min_digits = 1);
+        void append_duration(std::string &out, std::chrono::nanoseconds ns);
+        /* 12004 as "12,004" */
+        void append_grouped_number(std::string &out, size_t value);
+
+        /* A rate as shown: tenths of the value scaled below 1000, and the SI prefix (0 none, 1 k, 2 M, ...) */
+        struct ScaledRate
+        {
+            long long tenths;
+            size_t prefix;
+        };
+        ScaledRate scale_rate(double per_second);
+        /* "12.3 kit/s" for unit "it" */
+        void append_rate(std::string &out, ScaledRate rate, const std::string &unit);
+
+        /* append_duration() output, formatted again only when the displayed second changes */
+        class DurationText
+        {
+        public:
+            void append(std::string &out, std::chrono::nanoseconds ns);
+
+        private:
+            long long seconds_ = -1;
+            std::string text_;
+        };
+
+        /* ForegroundColor and FontStyles as one SGR sequence, built when the options change */
+        class StylePrefix
+        {
+        public:
+            void set(Color color, const std::vector<FontStyle> &styles);
+
+            /* Starts a frame that goes to `os` with the style, if `os` takes colors */
+            void append(std::string &out, std::ostream &os) const;
+
+            /* The SGR parameters alone, e.g. "36;1", empty without a style */
+            const std::string &codes() const
+            {
+                return codes_;
+            }
+
+        private:
+            std::string codes_;
+            std::string sequence_;
+            /* Kept for consoles that take colors through termcolor calls rather than escape sequences */
+            Color color_ = Color::unspecified;
+            std::vector<FontStyle> styles_;
+        };
     } // namespace details
 } // namespace indicators
 
@@ -41,15 +41,11 @@
 #ifndef INDICATORS_DISPLAY_WIDTH_H
 #define INDICATORS_DISPLAY_WIDTH_H
 
-#include <clocale>
-#if __has_include(<codecvt>)
-#include <codecvt>
-#define INDICATORS_HAVE_CODECVT 1
-#endif
+#include <cstddef>
+#include <string>
 
 namespace unicode
 {
-#if INDICATORS_HAVE_CODECVT
     namespace details
     {
         /*
@@ -114,12 +110,12 @@ namespace unicode
         */
         struct interval
         {
-            int first;
-            int last;
+            char32_t first;
+            char32_t last;
         };
 
         /* auxiliary function for binary search in interval table */
-        int bisearch(wchar_t ucs, const struct interval *table, int max);
+        int bisearch(char32_t ucs, const struct interval *table, int max);
 
         /*
             The following two functions define the column width of an ISO 10646
@@ -153,7 +149,7 @@ namespace unicode
             This implementation assumes that wchar_t characters are encoded
             in ISO 10646.
         */
-        int mk_wcwidth(wchar_t ucs);
+        int mk_wcwidth(char32_t ucs);
         int mk_wcswidth(const wchar_t *pwcs, size_t n);
 
         /*
@@ -165,10 +161,20 @@ namespace unicode
             the traditional terminal character-width behaviour. It is not
             otherwise recommended for general use.
         */
-        int mk_wcwidth_cjk(wchar_t ucs);
+        int mk_wcwidth_cjk(char32_t ucs);
 
         int mk_wcswidth_cjk(const wchar_t *pwcs, size_t n);
 
+        /*
+            Decodes one UTF-8 sequence at the start of [input, end) and returns its length.
+            Malformed and overlong sequences, surrogates and values past U+10FFFF decode
+            as a one byte U+FFFD.
+        */
+        size_t utf8_next(const unsigned char *input, const unsigned char *end, char32_t &ucs);
+
+        /* Length of the run of printable ASCII (U+0020-U+007E) at the start of [input, end) */
+        size_t printable_ascii_prefix(const unsigned char *input, const unsigned char *end);
+
         /* convert UTF-8 string to wstring */
         std::wstring utf8_decode(const std::string &str);
 
@@ -177,8 +183,12 @@ namespace unicode
 
     } // namespace details
 
-#endif
-
+    /*
+        Columns taken by UTF-8 text, as mk_wcswidth() counts them: the text ends at the
+        first NUL, and a control character makes the result -1. Works on the bytes
+        directly and does not allocate.
+    */
+    int display_width(const char *input, size_t length);
     int display_width(const std::string &input);
     int display_width(const std::wstring &input);
 
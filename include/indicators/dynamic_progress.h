@@ -40,39 +40,67 @@
 #ifndef INDICATORS_DYNAMIC_PROGRESS_H
 #define INDICATORS_DYNAMIC_PROGRESS_H
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <iostream>
 #include <mutex>
 #include <vector>
 
 #include <indicators/color.h>
+#include <indicators/frame_stats.h>
 #include <indicators/setting.h>
+#include <indicators/terminal_size.h>
+#include <indicators/details/frame_stream.h>
+#include <indicators/details/json_line.h>
+#include <indicators/details/plain_line.h>
+#include <indicators/details/redraw_throttle.h>
+#include <indicators/details/row_state.h>
+#include <indicators/details/status_cell.h>
 #include <indicators/details/stream_helper.h>
 
 namespace indicators
 {
+    class Renderer;
+    class StatusServer;
+    class PrometheusExporter;
+
     template <typename Indicator>
-    class DynamicProgress
+    class DynamicProgress : private details::RowListener
     {
-        using Settings = std::tuple<option::HideBarWhenComplete>;
+        using Settings = std::tuple<option::HideBarWhenComplete, option::MinRedrawInterval, option::OutputFormat, option::Clock>;
 
     public:
         template <typename... Indicators>
         explicit DynamicProgress(Indicators &... bars)
+            : settings_(option::HideBarWhenComplete{false}, option::MinRedrawInterval{std::chrono::nanoseconds::zero()}, option::OutputFormat{OutputFormat::automatic},
+                        option::Clock{&Clock::steady()})
         {
             bars_ = {bars...};
             for (auto &bar : bars_)
             {
                 bar.get().multi_progress_mode_ = true;
+                bar.get().row_.attach(this);
                 ++total_count_;
-                ++incomplete_count_;
+            }
+            on_option_changed();
+        }
+
+        DynamicProgress(const DynamicProgress &) = delete;
+        DynamicProgress &operator=(const DynamicProgress &) = delete;
+
+        ~DynamicProgress()
+        {
+            for (auto &bar : bars_)
+            {
+                bar.get().row_.detach(this);
             }
         }
 
+        /* Updates to the bar redraw its row; looking it up draws nothing */
         Indicator &operator[](size_t index)
         {
-            print_progress();
             std::lock_guard<std::mutex> lock{mutex_};
             return bars_[index].get();
         }
@@ -85,6 +113,7 @@ namespace indicators
             static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
             std::lock_guard<std::mutex> lock(mutex_);
             get_value<id>() = std::move(setting).value;
+            on_option_changed();
         }
 
         template <typename T, details::ProgressBarOption id>
@@ -93,15 +122,67 @@ namespace indicators
             static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
             std::lock_guard<std::mutex> lock(mutex_);
             get_value<id>() = setting.value;
+            on_option_changed();
+        }
+
+        void set_option(const details::Setting<std::ostream &, details::ProgressBarOption::stream> &setting)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stream_ = &setting.value;
+            on_option_changed();
+        }
+
+        void set_option(details::Setting<std::ostream &, details::ProgressBarOption::stream> &&setting)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stream_ = &setting.value;
+            on_option_changed();
+        }
+
+        FrameStats frame_stats()
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            return frame_stats_;
         }
 
     private:
         Settings settings_;
         std::atomic<bool> started_{false};
         std::mutex mutex_;
+
+        /* Set while a Renderer owns the terminal: updates then leave drawing to it */
+        friend class Renderer;
+        std::atomic<bool> renderer_mode_{false};
+
+        /* Read by a PrometheusExporter on its own thread */
+        friend class PrometheusExporter;
         std::vector<std::reference_wrapper<Indicator>> bars_;
+
+        /* Set while a StatusServer reports the rows, which then hears about new ones */
+        friend class StatusServer;
+        details::StatusBoard *status_board_{nullptr};
+
         std::atomic<size_t> total_count_{0};
-        std::atomic<size_t> incomplete_count_{0};
+        details::RedrawThrottle redraw_throttle_;
+        std::atomic<size_t> drawn_completed_count_{0};
+        /* Terminal width the last frame was drawn at, to find it again after a resize */
+        size_t drawn_width_{0};
+        /* Every row of a frame is composed here and written to the terminal at once */
+        details::FrameStream frame_;
+        /* option::Stream; frames go to std::cout unless another stream is given */
+        std::ostream *stream_{&std::cout};
+        /* option::Clock, or the steady clock when none is given */
+        const Clock *clock_{&Clock::steady()};
+        /* OutputFormat with automatic resolved against the stream, whenever the options change */
+        OutputFormat output_format_{OutputFormat::terminal};
+        FrameStats frame_stats_;
+        /* Columns each bar row and the summary row took in the last frame, to count the lines they wrap to */
+        std::vector<size_t> drawn_row_columns_;
+        size_t drawn_summary_columns_{0};
+        size_t drawn_summary_rows_{0};
+        /* Settings the last frame chose its rows with. While they hold, only dirty rows are drawn again. */
+        size_t drawn_height_{0};
+        bool drawn_hide_bar_when_complete_{false};
 
         template <details::ProgressBarOption id>
         auto get_value() -> decltype((details::get_value<id>(std::declval<Settings &>()).value))
@@ -116,9 +197,287 @@ namespace indicators
             return details::get_value<id>(settings_).value;
         }
 
+        /* "+<running> more running, <done> done" for the bars that did not fit on the screen */
+        void append_summary(std::string &out, size_t running, size_t done);
+
+        /* Draws a frame unless one was drawn less than MinRedrawInterval ago. Completions and new bars are always drawn. */
+        void redraw(bool completed);
+
+        void row_changed(bool completed) override
+        {
+            redraw(completed);
+        }
+
+        void on_option_changed();
+
+        /* Hands a composed frame to the terminal and counts it */
+        void write_frame(const std::string &frame);
+
+        /* OutputFormat::plain_lines and json_lines: a line for each row that changed and is due, nothing else */
+        void print_lines();
+
+        /* Terminal lines the bar rows and summary row of the last frame take at `width` columns */
+        size_t drawn_lines(size_t width) const;
+
     public:
         void print_progress();
     };
+
+    template <typename Indicator>
+    size_t DynamicProgress<Indicator>::push_back(Indicator &bar)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        bar.multi_progress_mode_ = true;
+        bar.row_.attach(this);
+        bars_.push_back(bar);
+        if (status_board_)
+        {
+            details::StatusCell *cell;
+            {
+                std::lock_guard<std::mutex> bar_lock{bar.mutex_};
+                cell = &bar.status_.cell();
+            }
+            status_board_->add_cell(*cell);
+        }
+        return bars_.size() - 1;
+    }
+
+    template <typename Indicator>
+    void DynamicProgress<Indicator>::redraw(bool completed)
+    {
+        if (renderer_mode_)
+        {
+            return;
+        }
+        std::chrono::nanoseconds min_redraw_interval;
+        std::chrono::nanoseconds now;
+        bool layout_changed;
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            min_redraw_interval = get_value<details::ProgressBarOption::min_redraw_interval>();
+            now = clock_->now();
+            if (output_format_ == OutputFormat::json_lines)
+            {
+                min_redraw_interval = details::json_line_interval(min_redraw_interval);
+            }
+            else if (output_format_ == OutputFormat::plain_lines)
+            {
+                min_redraw_interval = details::plain_line_interval(min_redraw_interval);
+            }
+            layout_changed = total_count_ != bars_.size();
+        }
+        if (layout_changed || completed || redraw_throttle_.try_claim(min_redraw_interval, now))
+        {
+            print_progress();
+        }
+    }
+
+    template <typename Indicator>
+    void DynamicProgress<Indicator>::append_summary(std::string &out, size_t running, size_t done)
+    {
+        out.push_back('+');
+        if (running > 0)
+        {
+            details::append_grouped_number(out, running);
+            out.append(done > 0 ? " more running, " : " more running");
+        }
+        if (done > 0)
+        {
+            details::append_grouped_number(out, done);
+            out.append(running > 0 ? " done" : " more done");
+        }
+        out.append("\033[K\n");
+    }
+
+    template <typename Indicator>
+    void DynamicProgress<Indicator>::on_option_changed()
+    {
+        output_format_ = details::resolve_output_format(get_value<details::ProgressBarOption::output_format>(), *stream_);
+        clock_ = get_value<details::ProgressBarOption::clock>() ? get_value<details::ProgressBarOption::clock>() : &Clock::steady();
+    }
+
+    template <typename Indicator>
+    void DynamicProgress<Indicator>::write_frame(const std::string &frame)
+    {
+        ++frame_stats_.frames;
+        frame_stats_.bytes += frame.size();
+        frame_stats_.last_frame_bytes = frame.size();
+        details::write_frame(*stream_, frame);
+    }
+
+    template <typename Indicator>
+    void DynamicProgress<Indicator>::print_lines()
+    {
+        frame_.reset(*stream_);
+        for (auto &bar : bars_)
+        {
+            if (!bar.get().take_row_dirty())
+            {
+                continue;
+            }
+            if (output_format_ == OutputFormat::json_lines)
+            {
+                bar.get().print_json(frame_);
+            }
+            else
+            {
+                bar.get().print_plain(frame_);
+            }
+        }
+        if (!frame_.str().empty())
+        {
+            write_frame(frame_.str());
+        }
+    }
+
+    template <typename Indicator>
+    size_t DynamicProgress<Indicator>::drawn_lines(size_t width) const
+    {
+        size_t lines = drawn_summary_rows_ > 0 ? wrapped_rows(drawn_summary_columns_, width) : 0;
+        for (const auto columns : drawn_row_columns_)
+        {
+            lines += wrapped_rows(columns, width);
+        }
+        return lines;
+    }
+
+    template <typename Indicator>
+    void DynamicProgress<Indicator>::print_progress()
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (output_format_ != OutputFormat::terminal)
+        {
+            print_lines();
+            return;
+        }
+        const auto hide_bar_when_complete = get_value<details::ProgressBarOption::hide_bar_when_complete>();
+        const auto size = terminal_size(*stream_);
+        const auto width = size.second;
+
+        size_t completed{0};
+        for (auto &bar : bars_)
+        {
+            completed += bar.get().is_completed() ? 1 : 0;
+        }
+        const auto running = bars_.size() - completed;
+
+        /*
+            Only as many rows as fit on the screen are rendered, keeping one for the summary
+            and one for the cursor. Running bars get the rows first, completed bars the rest
+            unless they are hidden. Bars keep their order on screen.
+        */
+        const auto candidates = hide_bar_when_complete ? running : bars_.size();
+        auto running_rows = running;
+        auto done_rows = hide_bar_when_complete ? size_t(0) : completed;
+        if (candidates >= size.first)
+        {
+            const auto capacity = std::max<size_t>(size.first, 3) - 2;
+            running_rows = std::min(running, capacity);
+            done_rows = std::min(done_rows, capacity - running_rows);
+        }
+        const auto hidden_running = running - running_rows;
+        const auto hidden_done = hide_bar_when_complete ? size_t(0) : completed - done_rows;
+        const size_t summary_rows = (hidden_running > 0 || hidden_done > 0) ? 1 : 0;
+
+        frame_.reset(*stream_);
+        auto &frame = frame_.str();
+        size_t running_drawn{0};
+        size_t done_drawn{0};
+        auto redraw_all = !started_ || width != drawn_width_ || size.first != drawn_height_ || bars_.size() != total_count_ ||
+                          completed != drawn_completed_count_ || hide_bar_when_complete != drawn_hide_bar_when_complete_;
+        if (!redraw_all)
+        {
+            // Same rows as the last frame: the cursor moves up to each dirty one and back below the frame.
+            // Rows wider than the terminal wrap, so the cursor moves by terminal lines.
+            const auto bottom = drawn_lines(width);
+            size_t cursor = bottom;
+            size_t top = 0;
+            size_t row = 0;
+            for (auto &bar : bars_)
+            {
+                if (row == drawn_row_columns_.size() || redraw_all)
+                {
+                    break;
+                }
+                if (bar.get().is_completed() ? done_drawn++ < done_rows : running_drawn++ < running_rows)
+                {
+                    const auto lines = wrapped_rows(drawn_row_columns_[row], width);
+                    if (bar.get().take_row_dirty())
+                    {
+                        details::append_cursor_up(frame, cursor - top);
+                        frame.push_back('\r');
+                        const auto offset = frame.size();
+                        bar.get().print_row(frame_);
+                        const auto columns = frame_.columns_since(offset);
+                        frame.push_back('\r');
+                        // A row that wraps to more or fewer lines than before moves the rows below it
+                        redraw_all = wrapped_rows(columns, width) != lines;
+                        drawn_row_columns_[row] = redraw_all ? drawn_row_columns_[row] : columns;
+                        cursor = top + lines - 1;
+                    }
+                    top += lines;
+                    ++row;
+                }
+            }
+            if (!redraw_all)
+            {
+                if (cursor == bottom)
+                {
+                    return;
+                }
+                details::append_cursor_down(frame, bottom - cursor);
+                frame_.clear_style();
+                write_frame(frame);
+                return;
+            }
+            // Drops the rows composed before a row turned out to wrap differently
+            frame_.reset(*stream_);
+            running_drawn = 0;
+            done_drawn = 0;
+        }
+
+        if (started_)
+        {
+            details::append_cursor_up(frame, drawn_lines(width));
+            if (width != drawn_width_)
+            {
+                // Clear whatever the reflow of the last frame left below the new one
+                frame.append("\033[J");
+            }
+        }
+        drawn_row_columns_.clear();
+        for (auto &bar : bars_)
+        {
+            if (bar.get().is_completed() ? done_drawn++ < done_rows : running_drawn++ < running_rows)
+            {
+                bar.get().take_row_dirty();
+                const auto offset = frame.size();
+                bar.get().print_row(frame_);
+                drawn_row_columns_.push_back(frame_.columns_since(offset));
+                frame.push_back('\n');
+            }
+        }
+        frame_.clear_style();
+        if (summary_rows > 0)
+        {
+            const auto offset = frame.size();
+            append_summary(frame, hidden_running, hidden_done);
+            drawn_summary_columns_ = frame_.columns_since(offset);
+        }
+        // Rows of the last frame that this one did not overwrite, such as bars hidden since
+        frame.append("\033[J");
+        if (!started_)
+        {
+            started_ = true;
+        }
+        total_count_ = bars_.size();
+        drawn_completed_count_ = completed;
+        drawn_width_ = width;
+        drawn_summary_rows_ = summary_rows;
+        drawn_height_ = size.first;
+        drawn_hide_bar_when_complete_ = hide_bar_when_complete;
+        write_frame(frame);
+    }
 } // namespace indicators
 
 #endif // INDICATORS_DYNAMIC_PROGRESS_H
\ No newline at end of file
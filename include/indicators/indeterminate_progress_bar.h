@@ -57,6 +57,13 @@
 #include <indicators/color.h>
 #include <indicators/setting.h>
 #include <indicators/terminal_size.h>
+#include <indicators/details/frame_stream.h>
+#include <indicators/details/json_line.h>
+#include <indicators/details/plain_line.h>
+#include <indicators/details/prometheus_text.h>
+#include <indicators/details/redraw_throttle.h>
+#include <indicators/details/row_state.h>
+#include <indicators/details/status_cell.h>
 #include <indicators/details/stream_helper.h>
 
 namespace indicators
@@ -65,7 +72,8 @@ namespace indicators
     {
         using Settings = std::tuple<option::BarWidth, option::PrefixText, option::PostfixText, option::Start,
                                     option::End, option::Fill, option::Lead, option::MaxPostfixTextLen,
-                                    option::Completed, option::ForegroundColor, option::FontStyles, option::Stream>;
+                                    option::Completed, option::ForegroundColor, option::FontStyles, option::Stream,
+                                    option::MinRedrawInterval, option::OutputFormat, option::Clock, option::Label>;
 
         enum class Direction
         {
@@ -89,7 +97,11 @@ namespace indicators
                         details::get<details::ProgressBarOption::completed>(option::Completed{false}, std::forward<Args>(args)...),
                         details::get<details::ProgressBarOption::foreground_color>(option::ForegroundColor{Color::unspecified}, std::forward<Args>(args)...),
                         details::get<details::ProgressBarOption::font_styles>(option::FontStyles{std::vector<FontStyle>{}}, std::forward<Args>(args)...),
-                        details::get<details::ProgressBarOption::stream>(option::Stream{std::cout}, std::forward<Args>(args)...))
+                        details::get<details::ProgressBarOption::stream>(option::Stream{std::cout}, std::forward<Args>(args)...),
+                        details::get<details::ProgressBarOption::min_redraw_interval>(option::MinRedrawInterval{std::chrono::nanoseconds::zero()}, std::forward<Args>(args)...),
+                        details::get<details::ProgressBarOption::output_format>(option::OutputFormat{OutputFormat::automatic}, std::forward<Args>(args)...),
+                        details::get<details::ProgressBarOption::clock>(option::Clock{&Clock::steady()}, std::forward<Args>(args)...),
+                        details::get<details::ProgressBarOption::label>(option::Label{}, std::forward<Args>(args)...))
         {
             // starts with [<==>...........]
             // progress_ = 0
@@ -103,6 +115,7 @@ namespace indicators
                             get_value<details::ProgressBarOption::lead>().size() +
                             get_value<details::ProgressBarOption::start>().size() +
                             get_value<details::ProgressBarOption::end>().size();
+            on_option_changed();
         }
 
         template <typename T, details::ProgressBarOption id>
@@ -111,6 +124,7 @@ namespace indicators
             static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
             std::lock_guard<std::mutex> lock(mutex_);
             get_value<id>() = std::move(setting).value;
+            on_option_changed();
         }
 
         template <typename T, details::ProgressBarOption id>
@@ -119,6 +133,7 @@ namespace indicators
             static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
             std::lock_guard<std::mutex> lock(mutex_);
             get_value<id>() = setting.value;
+            on_option_changed();
         }
 
         void set_option(const details::Setting<std::string, details::ProgressBarOption::postfix_text> &setting);
@@ -147,7 +162,10 @@ namespace indicators
         size_t progress_{0};
         size_t max_progress_;
         Settings settings_;
-        std::chrono::nanoseconds elapsed_;
+        /* Time of the first tick, and the time it took once completed */
+        std::chrono::nanoseconds start_time_{0};
+        std::chrono::nanoseconds elapsed_{0};
+        bool started_{false};
         std::mutex mutex_;
 
         template <typename Indicator, size_t count>
@@ -155,10 +173,68 @@ namespace indicators
         template <typename Indicator>
         friend class DynamicProgress;
         std::atomic<bool> multi_progress_mode_{false};
+        details::RowState row_;
 
-        std::pair<std::string, size_t> get_prefix_text();
+        /* Snapshots for a StatusServer, published while the bar draws */
+        friend class StatusServer;
+        details::StatusSlot status_;
 
-        std::pair<std::string, size_t> get_postfix_text();
+        /* Frame buffer reused between renders, so a steady-state frame does not allocate */
+        std::string line_;
+        details::StylePrefix style_;
+        details::IndeterminateProgressScaleWriter scale_writer_;
+        size_t prefix_width_{0};
+        size_t postfix_text_width_{0};
+        bool layout_dirty_{true};
+        details::RedrawThrottle redraw_throttle_;
+        /* option::Clock, read without the mutex by whoever claims the next frame */
+        std::atomic<const Clock *> clock_{&Clock::steady()};
+
+        std::chrono::nanoseconds now() const { return clock_.load(std::memory_order_acquire)->now(); }
+
+        /* OutputFormat with automatic resolved against the stream, whenever the options change */
+        OutputFormat output_format_{OutputFormat::terminal};
+        details::PlainLineSchedule plain_schedule_;
+
+        void on_option_changed();
+
+        void update_layout();
+
+        size_t append_prefix_text(std::string &out);
+
+        size_t append_postfix_text(std::string &out);
+
+        void append_json(std::string &out);
+
+        void publish_status();
+
+        /* Read by a PrometheusExporter on its own thread */
+        friend class PrometheusExporter;
+
+        void collect_metrics(details::BarMetrics &metrics);
+
+        /* Appends prefix, bar and postfix to line_ and returns their display width */
+        size_t compose_row();
+
+        /* OutputFormat::plain_lines: the row without escapes or padding, when its schedule says so */
+        void write_plain_line(std::ostream &os, bool final);
+
+        void draw_progress(std::ostream &os, bool from_multi_progress);
+
+        /* Rows of a container's frame are as wide as the terminal the frame goes to, not this bar's stream */
+        void draw_progress(std::ostream &os, bool from_multi_progress, size_t terminal_width);
+
+        /* Draws this bar's row into the frame MultiProgress or DynamicProgress is composing */
+        void print_row(details::FrameStream &frame);
+
+        /* Whether the row has to be drawn again since it was last drawn */
+        bool take_row_dirty();
+
+        /* Writes this bar's JSON line into the output of a container in OutputFormat::json_lines */
+        void print_json(std::ostream &os);
+
+        /* Writes this bar's plain line into the output of a container in OutputFormat::plain_lines, when due */
+        void print_plain(std::ostream &os);
 
     public:
         void print_progress(bool from_multi_progress = false);
@@ -40,29 +40,60 @@
 #ifndef INDICATORS_MULTI_PROGRESS_H
 #define INDICATORS_MULTI_PROGRESS_H
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <iostream>
 #include <mutex>
+#include <tuple>
 #include <vector>
 
 #include <indicators/color.h>
 #include <indicators/cursor_movement.h>
+#include <indicators/frame_stats.h>
+#include <indicators/setting.h>
+#include <indicators/terminal_size.h>
+#include <indicators/details/frame_stream.h>
+#include <indicators/details/json_line.h>
+#include <indicators/details/plain_line.h>
+#include <indicators/details/redraw_throttle.h>
+#include <indicators/details/row_state.h>
 #include <indicators/details/stream_helper.h>
 
 namespace indicators
 {
+    class Renderer;
+    class StatusServer;
+    class PrometheusExporter;
+
     template <typename Indicator, size_t count>
-    class MultiProgress
+    class MultiProgress : private details::RowListener
     {
+        using Settings = std::tuple<option::MinRedrawInterval, option::OutputFormat, option::Clock>;
+
     public:
         template <typename... Indicators, typename = typename std::enable_if<(sizeof...(Indicators) == count)>::type>
         explicit MultiProgress(Indicators &... bars)
+            : settings_(option::MinRedrawInterval{std::chrono::nanoseconds::zero()}, option::OutputFormat{OutputFormat::automatic}, option::Clock{&Clock::steady()})
         {
             bars_ = {bars...};
             for (auto &bar : bars_)
             {
                 bar.get().multi_progress_mode_ = true;
+                bar.get().row_.attach(this);
+            }
+            on_option_changed();
+        }
+
+        MultiProgress(const MultiProgress &) = delete;
+        MultiProgress &operator=(const MultiProgress &) = delete;
+
+        ~MultiProgress()
+        {
+            for (auto &bar : bars_)
+            {
+                bar.get().row_.detach(this);
             }
         }
 
@@ -73,7 +104,6 @@ namespace indicators
             {
                 bars_[index].get().set_progress(value);
             }
-            print_progress();
         }
 
         template <size_t index>
@@ -83,7 +113,6 @@ namespace indicators
             {
                 bars_[index].get().set_progress(value);
             }
-            print_progress();
         }
 
         template <size_t index>
@@ -93,7 +122,6 @@ namespace indicators
             {
                 bars_[index].get().tick();
             }
-            print_progress();
         }
 
         template <size_t index>
@@ -102,16 +130,290 @@ namespace indicators
             return bars_[index].get().is_completed();
         }
 
+        template <typename T, details::ProgressBarOption id>
+        void set_option(details::Setting<T, id> &&setting)
+        {
+            static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
+            std::lock_guard<std::mutex> lock(mutex_);
+            get_value<id>() = std::move(setting).value;
+            on_option_changed();
+        }
+
+        template <typename T, details::ProgressBarOption id>
+        void set_option(const details::Setting<T, id> &setting)
+        {
+            static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
+            std::lock_guard<std::mutex> lock(mutex_);
+            get_value<id>() = setting.value;
+            on_option_changed();
+        }
+
+        void set_option(const details::Setting<std::ostream &, details::ProgressBarOption::stream> &setting)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stream_ = &setting.value;
+            on_option_changed();
+        }
+
+        void set_option(details::Setting<std::ostream &, details::ProgressBarOption::stream> &&setting)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stream_ = &setting.value;
+            on_option_changed();
+        }
+
+        FrameStats frame_stats()
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            return frame_stats_;
+        }
+
     private:
+        Settings settings_;
         std::atomic<bool> started_{false};
         std::mutex mutex_;
+
+        /* Set while a Renderer owns the terminal: updates then leave drawing to it */
+        friend class Renderer;
+        std::atomic<bool> renderer_mode_{false};
+
+        /* Also read by a StatusServer or PrometheusExporter, from their own threads */
+        friend class StatusServer;
+        friend class PrometheusExporter;
         std::vector<std::reference_wrapper<Indicator>> bars_;
+        details::RedrawThrottle redraw_throttle_;
+        std::atomic<size_t> drawn_completed_count_{0};
+        /* Terminal width the last frame was drawn at, to find it again after a resize */
+        size_t drawn_width_{0};
+        /* Columns each row took when last drawn, to count the lines it wraps to */
+        std::array<size_t, count> row_columns_{};
+        /* Every row of a frame is composed here and written to the terminal at once */
+        details::FrameStream frame_;
+        /* option::Stream; frames go to std::cout unless another stream is given */
+        std::ostream *stream_{&std::cout};
+        /* option::Clock, or the steady clock when none is given */
+        const Clock *clock_{&Clock::steady()};
+        /* OutputFormat with automatic resolved against the stream, whenever the options change */
+        OutputFormat output_format_{OutputFormat::terminal};
+        FrameStats frame_stats_;
+
+        template <details::ProgressBarOption id>
+        auto get_value() -> decltype((details::get_value<id>(std::declval<Settings &>()).value))
+        {
+            return details::get_value<id>(settings_).value;
+        }
+
+        template <details::ProgressBarOption id>
+        auto get_value() const
+            -> decltype((details::get_value<id>(std::declval<const Settings &>()).value))
+        {
+            return details::get_value<id>(settings_).value;
+        }
 
         bool _all_completed();
 
+        size_t completed_count();
+
+        /* Draws a frame unless one was drawn less than MinRedrawInterval ago. Completions are always drawn. */
+        void redraw(bool completed);
+
+        void row_changed(bool completed) override
+        {
+            redraw(completed);
+        }
+
+        void on_option_changed();
+
+        /* Hands a composed frame to the terminal and counts it */
+        void write_frame(const std::string &frame);
+
+        /* OutputFormat::plain_lines and json_lines: a line for each row that changed and is due, nothing else */
+        void print_lines();
+
+        /* Terminal lines the rows of the last frame take at `width` columns */
+        size_t drawn_lines(size_t width) const;
+
     public:
         void print_progress();
     };
+
+    template <typename Indicator, size_t count>
+    bool MultiProgress<Indicator, count>::_all_completed()
+    {
+        bool result{true};
+        for (size_t i = 0; i < count; ++i)
+        {
+            result &= bars_[i].get().is_completed();
+        }
+        return result;
+    }
+
+    template <typename Indicator, size_t count>
+    size_t MultiProgress<Indicator, count>::completed_count()
+    {
+        size_t result{0};
+        for (auto &bar : bars_)
+        {
+            result += bar.get().is_completed() ? 1 : 0;
+        }
+        return result;
+    }
+
+    template <typename Indicator, size_t count>
+    void MultiProgress<Indicator, count>::redraw(bool completed)
+    {
+        if (renderer_mode_)
+        {
+            return;
+        }
+        std::chrono::nanoseconds min_redraw_interval;
+        std::chrono::nanoseconds now;
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            min_redraw_interval = get_value<details::ProgressBarOption::min_redraw_interval>();
+            now = clock_->now();
+            if (output_format_ == OutputFormat::json_lines)
+            {
+                min_redraw_interval = details::json_line_interval(min_redraw_interval);
+            }
+            else if (output_format_ == OutputFormat::plain_lines)
+            {
+                min_redraw_interval = details::plain_line_interval(min_redraw_interval);
+            }
+        }
+        if (completed || redraw_throttle_.try_claim(min_redraw_interval, now))
+        {
+            print_progress();
+        }
+    }
+
+    template <typename Indicator, size_t count>
+    void MultiProgress<Indicator, count>::on_option_changed()
+    {
+        output_format_ = details::resolve_output_format(get_value<details::ProgressBarOption::output_format>(), *stream_);
+        clock_ = get_value<details::ProgressBarOption::clock>() ? get_value<details::ProgressBarOption::clock>() : &Clock::steady();
+    }
+
+    template <typename Indicator, size_t count>
+    void MultiProgress<Indicator, count>::write_frame(const std::string &frame)
+    {
+        ++frame_stats_.frames;
+        frame_stats_.bytes += frame.size();
+        frame_stats_.last_frame_bytes = frame.size();
+        details::write_frame(*stream_, frame);
+    }
+
+    template <typename Indicator, size_t count>
+    void MultiProgress<Indicator, count>::print_lines()
+    {
+        frame_.reset(*stream_);
+        for (auto &bar : bars_)
+        {
+            if (!bar.get().take_row_dirty())
+            {
+                continue;
+            }
+            if (output_format_ == OutputFormat::json_lines)
+            {
+                bar.get().print_json(frame_);
+            }
+            else
+            {
+                bar.get().print_plain(frame_);
+            }
+        }
+        if (!frame_.str().empty())
+        {
+            write_frame(frame_.str());
+        }
+    }
+
+    template <typename Indicator, size_t count>
+    size_t MultiProgress<Indicator, count>::drawn_lines(size_t width) const
+    {
+        size_t lines = 0;
+        for (const auto columns : row_columns_)
+        {
+            lines += wrapped_rows(columns, width);
+        }
+        return lines;
+    }
+
+    template <typename Indicator, size_t count>
+    void MultiProgress<Indicator, count>::print_progress()
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (output_format_ != OutputFormat::terminal)
+        {
+            print_lines();
+            return;
+        }
+        const auto width = terminal_width(*stream_);
+        frame_.reset(*stream_);
+        auto &frame = frame_.str();
+        auto redraw_all = !started_ || width != drawn_width_;
+        if (!redraw_all)
+        {
+            // Only the rows that changed: the cursor moves up to each one and back below the last row.
+            // Rows wider than the terminal wrap, so the cursor moves by terminal lines.
+            const auto bottom = drawn_lines(width);
+            size_t cursor = bottom;
+            size_t top = 0;
+            for (size_t i = 0; i < count && !redraw_all; ++i)
+            {
+                const auto lines = wrapped_rows(row_columns_[i], width);
+                if (bars_[i].get().take_row_dirty())
+                {
+                    details::append_cursor_up(frame, cursor - top);
+                    frame.push_back('\r');
+                    const auto offset = frame.size();
+                    bars_[i].get().print_row(frame_);
+                    const auto columns = frame_.columns_since(offset);
+                    frame.push_back('\r');
+                    // A row that wraps to more or fewer lines than before moves the rows below it
+                    redraw_all = wrapped_rows(columns, width) != lines;
+                    row_columns_[i] = redraw_all ? row_columns_[i] : columns;
+                    cursor = top + lines - 1;
+                }
+                top += lines;
+            }
+            if (!redraw_all)
+            {
+                if (cursor == bottom)
+                {
+                    return;
+                }
+                details::append_cursor_down(frame, bottom - cursor);
+            }
+        }
+        if (redraw_all)
+        {
+            // Drops the rows composed before a row turned out to wrap differently
+            frame_.reset(*stream_);
+            if (started_)
+            {
+                details::append_cursor_up(frame, drawn_lines(width));
+                // Clear whatever the reflow of the last frame left below the new one
+                frame.append("\033[J");
+            }
+            for (size_t i = 0; i < count; ++i)
+            {
+                bars_[i].get().take_row_dirty();
+                const auto offset = frame.size();
+                bars_[i].get().print_row(frame_);
+                row_columns_[i] = frame_.columns_since(offset);
+                frame.push_back('\n');
+            }
+        }
+        frame_.clear_style();
+        write_frame(frame);
+        if (!started_)
+        {
+            started_ = true;
+        }
+        drawn_completed_count_ = completed_count();
+        drawn_width_ = width;
+    }
 } // namespace indicators
 
 #endif // INDICATORS_MULTI_PROGRESS_H
\ No newline at end of file
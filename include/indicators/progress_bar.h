@@ -46,6 +46,7 @@
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <mutex>
 #include <string>
@@ -57,10 +58,24 @@
 #include <indicators/color.h>
 #include <indicators/setting.h>
 #include <indicators/terminal_size.h>
+#include <indicators/details/frame_key.h>
+#include <indicators/details/frame_stream.h>
+#include <indicators/details/json_line.h>
+#include <indicators/details/plain_line.h>
+#include <indicators/details/prometheus_text.h>
+#include <indicators/details/rate_estimator.h>
+#include <indicators/details/redraw_throttle.h>
+#include <indicators/details/row_state.h>
+#include <indicators/details/sharded_counter.h>
+#include <indicators/details/status_cell.h>
 #include <indicators/details/stream_helper.h>
 
 namespace indicators
 {
+    class Renderer;
+    class StatusServer;
+    class PrometheusExporter;
+
     class ProgressBar
     {
         using Settings =
@@ -71,7 +86,9 @@ namespace indicators
                        option::ShowElapsedTime, option::ShowRemainingTime,
                        option::SavedStartTime, option::ForegroundColor,
                        option::FontStyles, option::MinProgress, option::MaxProgress,
-                       option::ProgressType, option::Stream>;
+                       option::ProgressType, option::Stream, option::MinRedrawInterval,
+                       option::ShardedProgress, option::OutputFormat, option::ShowRate,
+                       option::RateUnit, option::SharedState, option::Label, option::Clock>;
 
     public:
         template <typename... Args, typename std::enable_if<details::are_settings_from_tuple<Settings, typename std::decay<Args>::type...>::value, void *>::type = nullptr>
@@ -96,18 +113,31 @@ namespace indicators
                   details::get<details::ProgressBarOption::min_progress>(option::MinProgress{0}, std::forward<Args>(args)...),
                   details::get<details::ProgressBarOption::max_progress>(option::MaxProgress{100}, std::forward<Args>(args)...),
                   details::get<details::ProgressBarOption::progress_type>(option::ProgressType{ProgressType::incremental}, std::forward<Args>(args)...),
-                  details::get<details::ProgressBarOption::stream>(option::Stream{std::cout}, std::forward<Args>(args)...))
+                  details::get<details::ProgressBarOption::stream>(option::Stream{std::cout}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::min_redraw_interval>(option::MinRedrawInterval{std::chrono::nanoseconds::zero()}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::sharded_progress>(option::ShardedProgress{false}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::output_format>(option::OutputFormat{OutputFormat::automatic}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::show_rate>(option::ShowRate{false}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::rate_unit>(option::RateUnit{"it"}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::shared_state>(option::SharedState{nullptr}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::label>(option::Label{}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::clock>(option::Clock{&Clock::steady()}, std::forward<Args>(args)...))
         {
             /* if progress is incremental, start from min_progress else start from max_progress */
             const auto type = get_value<details::ProgressBarOption::progress_type>();
             if (type == ProgressType::incremental)
             {
-                progress_ = get_value<details::ProgressBarOption::min_progress>();
+                local_progress_ = get_value<details::ProgressBarOption::min_progress>();
             }
             else
             {
-                progress_ = get_value<details::ProgressBarOption::max_progress>();
+                local_progress_ = get_value<details::ProgressBarOption::max_progress>();
+            }
+            if (get_value<details::ProgressBarOption::completed>())
+            {
+                state_ = State::completed;
             }
+            on_option_changed();
         }
 
         template <typename T, details::ProgressBarOption id>
@@ -116,6 +146,7 @@ namespace indicators
             static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
             std::lock_guard<std::mutex> lock(mutex_);
             get_value<id>() = std::move(setting).value;
+            on_option_changed();
         }
 
         template <typename T, details::ProgressBarOption id>
@@ -124,25 +155,49 @@ namespace indicators
             static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
             std::lock_guard<std::mutex> lock(mutex_);
             get_value<id>() = setting.value;
+            on_option_changed();
         }
 
         void set_option(const details::Setting<std::string, details::ProgressBarOption::postfix_text> &setting);
 
         void set_option(details::Setting<std::string, details::ProgressBarOption::postfix_text> &&setting);
 
+        void set_option(const details::Setting<bool, details::ProgressBarOption::completed> &setting);
+
+        void set_option(details::Setting<bool, details::ProgressBarOption::completed> &&setting);
+
         void set_progress(size_t new_progress);
 
+        /*
+            Wait-free unless this update completes the bar or is due for a redraw.
+            With option::ShardedProgress the update lands in a per-CPU slot instead.
+        */
         void tick();
 
+        void tick(size_t n);
+
         size_t current();
 
         bool is_completed() const
         {
-            return get_value<details::ProgressBarOption::completed>();
+            return state_.load(std::memory_order_acquire) != State::running;
         }
 
         void mark_as_completed();
 
+        /*
+            Makes this bar the aggregate of `child`. Each child adds `weight` to the work this
+            bar tracks and moves its progress as the child advances, so progress, MaxProgress
+            and the remaining time of an aggregate count weighted work, aggregate_resolution
+            units per unit of weight. Children can be added after start and can have children
+            of their own. A child of weight 0 adds no work, and an aggregate without any work
+            shows 100%. An aggregate is not ticked directly.
+            In DynamicProgress, children pushed after their parent are drawn as its subtree.
+        */
+        void add_child(ProgressBar &child, size_t weight = 1);
+
+        static constexpr size_t aggregate_resolution = 10000;
+
     private:
         template <details::ProgressBarOption id>
         auto get_value() -> decltype((details::get_value<id>(std::declval<Settings &>()).value))
@@ -156,10 +211,58 @@ namespace indicators
             return details::get_value<id>(settings_).value;
         }
 
-        size_t progress_{0};
+        /*
+            running -> finishing: claimed by the update that reaches the end, which then draws the last frame
+                                  (or leaves it to the attached Renderer)
+            finishing -> completed: set once that last frame has been rendered
+        */
+        enum class State
+        {
+            running,
+            finishing,
+            completed
+        };
+
+        std::atomic<size_t> local_progress_{0};
+        std::atomic<State> state_{State::running};
+
+        /*
+            Where updates count: local_progress_, or the progress in the option::SharedState
+            slot once that is bound. A bound slot is kept for the bar's lifetime.
+        */
+        std::atomic<std::atomic<size_t> *> counter_{&local_progress_};
+        std::atomic<details::SharedBarState *> shared_{nullptr};
+        /* What the owner of the slot last saw of it */
+        size_t shared_progress_{0};
+        unsigned shared_postfix_version_{0};
+        std::string shared_postfix_;
+
+        /*
+            Created once option::ShardedProgress is enabled and kept for the bar's lifetime.
+            The progress is then the counter plus the sum of the shards.
+        */
+        std::unique_ptr<details::ShardedCounter> shard_storage_;
+        std::atomic<details::ShardedCounter *> shards_{nullptr};
+
+        /* Copies of the settings read by the lock-free update path, refreshed by on_option_changed() */
+        std::atomic<bool> decremental_{false};
+        std::atomic<size_t> min_progress_{0};
+        std::atomic<size_t> max_progress_{0};
+        std::atomic<long long> min_redraw_interval_ns_{0};
+        std::atomic<bool> start_time_pending_{false};
+        std::atomic<bool> shows_time_{false};
+
+        /* Aggregate this bar reports to, and the weighted work it has reported so far */
+        std::atomic<ProgressBar *> parent_{nullptr};
+        std::atomic<size_t> parent_weight_{0};
+        std::atomic<size_t> parent_work_{0};
+        size_t child_count_{0};
+
         Settings settings_;
         std::chrono::nanoseconds elapsed_;
-        std::chrono::time_point<std::chrono::high_resolution_clock> start_time_point_;
+        std::chrono::nanoseconds start_time_{0};
+        /* Sampled with the elapsed time whenever a frame or line is drawn */
+        details::RateEstimator rate_;
         std::mutex mutex_;
 
         template <typename Indicator, size_t count>
@@ -167,12 +270,126 @@ namespace indicators
         template <typename Indicator>
         friend class DynamicProgress;
         std::atomic<bool> multi_progress_mode_{false};
+        details::RowState row_;
+        /* Elapsed second the row was last drawn at, so the container redraws it when the shown time moves on */
+        long long row_second_{-1};
+
+        /* Set while a Renderer owns the terminal: updates then only change the state */
+        friend class Renderer;
+        std::atomic<bool> renderer_mode_{false};
+
+        /* Snapshots for a StatusServer, published while the bar draws */
+        friend class StatusServer;
+        details::StatusSlot status_;
+
+        /* Frame buffer reused between renders, so a steady-state frame does not allocate */
+        std::string line_;
+        details::StylePrefix style_;
+        details::ProgressScaleWriter scale_writer_;
+        size_t prefix_width_{0};
+        size_t postfix_text_width_{0};
+        bool layout_dirty_{true};
+        size_t layout_version_{0};
+        details::RedrawThrottle redraw_throttle_;
+        /* option::Clock, read without the mutex by whoever claims the next frame */
+        std::atomic<const Clock *> clock_{&Clock::steady()};
+
+        std::chrono::nanoseconds now() const { return clock_.load(std::memory_order_acquire)->now(); }
+
+        /* Key of the last frame written, to skip frames that would look the same */
+        details::FrameKey drawn_key_;
+        details::DurationText elapsed_text_;
+        details::DurationText remaining_text_;
+
+        /* OutputFormat with automatic resolved against the stream, whenever the options change */
+        OutputFormat output_format_{OutputFormat::terminal};
+        details::PlainLineSchedule plain_schedule_;
+
+        std::atomic<size_t> &counter() const
+        {
+            return *counter_.load(std::memory_order_acquire);
+        }
+
+        void on_option_changed();
+
+        void bind_shared_state(details::SharedBarState *shared);
+
+        /*
+            In the owner of a shared slot, picks up what the workers did: a new MaxProgress
+            or postfix, progress and completion. Returns whether the row has to be redrawn.
+        */
+        bool sync_shared_state();
+
+        void on_progress_changed(bool at_end);
+
+        size_t load_progress() const;
+
+        bool sharded_reached_end(const details::ShardedCounter &shards) const;
 
         void save_start_time();
 
-        std::pair<std::string, size_t> get_prefix_text();
+        size_t weighted_work(size_t progress) const;
+
+        void update_parent(size_t progress);
+
+        void add_work(size_t delta);
+
+        /* Back to running once more work was added to a completed aggregate */
+        void reopen();
+
+        bool reached_end(size_t progress) const;
+
+        void update_layout();
+
+        size_t append_prefix_text(std::string &out);
+
+        /* Progress made since MinProgress, or since MaxProgress for a decremental bar */
+        size_t done_work(size_t progress) const;
+
+        void update_elapsed(size_t progress);
+
+        /* Progress in percent of MaxProgress, 100 when MaxProgress is 0 */
+        double exact_percentage(size_t progress) const;
+
+        size_t percentage(size_t progress) const;
+
+        std::chrono::nanoseconds remaining_time(size_t progress) const;
+
+        details::FrameKey frame_key(size_t progress, size_t terminal_width) const;
+
+        size_t append_postfix_text(std::string &out, size_t progress);
+
+        void append_json(std::string &out, size_t progress);
+
+        void publish_status(size_t progress);
+
+        /* Read by a PrometheusExporter on its own thread */
+        friend class PrometheusExporter;
+
+        void collect_metrics(details::BarMetrics &metrics);
+
+        /* Appends prefix, bar and postfix to line_ and returns their display width */
+        size_t compose_row(size_t progress);
+
+        /* OutputFormat::plain_lines: the row without escapes or padding, when its schedule says so */
+        void write_plain_line(std::ostream &os, size_t progress, bool final);
+
+        void draw_progress(std::ostream &os, bool from_multi_progress);
+
+        /* Rows of a container's frame are as wide as the terminal the frame goes to, not this bar's stream */
+        void draw_progress(std::ostream &os, bool from_multi_progress, size_t terminal_width);
+
+        /* Draws this bar's row into the frame MultiProgress or DynamicProgress is composing */
+        void print_row(details::FrameStream &frame);
+
+        /* Whether the row has to be drawn again: the bar changed, or the time it shows did */
+        bool take_row_dirty();
+
+        /* Writes this bar's JSON line into the output of a container in OutputFormat::json_lines */
+        void print_json(std::ostream &os);
 
-        std::pair<std::string, size_t> get_postfix_text();
+        /* Writes this bar's plain line into the output of a container in OutputFormat::plain_lines, when due */
+        void print_plain(std::ostream &os);
 
     public:
         void print_progress(bool from_multi_progress = false);
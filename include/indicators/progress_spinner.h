@@ -54,6 +54,9 @@
 
 #include <indicators/color.h>
 #include <indicators/setting.h>
+#include <indicators/details/plain_line.h>
+#include <indicators/details/prometheus_text.h>
+#include <indicators/details/redraw_throttle.h>
 #include <indicators/details/stream_helper.h>
 
 namespace indicators
@@ -65,7 +68,8 @@ namespace indicators
                        option::ShowPercentage, option::ShowElapsedTime, option::ShowRemainingTime,
                        option::ShowSpinner, option::SavedStartTime, option::Completed,
                        option::MaxPostfixTextLen, option::SpinnerStates, option::FontStyles,
-                       option::MaxProgress, option::Stream>;
+                       option::MaxProgress, option::Stream, option::MinRedrawInterval,
+                       option::OutputFormat, option::Clock, option::Label>;
 
     public:
         template <typename... Args, typename std::enable_if<details::are_settings_from_tuple<Settings, typename std::decay<Args>::type...>::value, void *>::type = nullptr>
@@ -84,7 +88,14 @@ namespace indicators
                   details::get<details::ProgressBarOption::spinner_states>(option::SpinnerStates{std::vector<std::string>{"⠋", "⠙", "⠹", "⠸", "⠼", "⠴", "⠦", "⠧", "⠇", "⠏"}}, std::forward<Args>(args)...),
                   details::get<details::ProgressBarOption::font_styles>(option::FontStyles{std::vector<FontStyle>{}}, std::forward<Args>(args)...),
                   details::get<details::ProgressBarOption::max_progress>(option::MaxProgress{100}, std::forward<Args>(args)...),
-                  details::get<details::ProgressBarOption::stream>(option::Stream{std::cout}, std::forward<Args>(args)...)) {}
+                  details::get<details::ProgressBarOption::stream>(option::Stream{std::cout}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::min_redraw_interval>(option::MinRedrawInterval{std::chrono::nanoseconds::zero()}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::output_format>(option::OutputFormat{OutputFormat::automatic}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::clock>(option::Clock{&Clock::steady()}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::label>(option::Label{}, std::forward<Args>(args)...))
+        {
+            on_option_changed();
+        }
 
         template <typename T, details::ProgressBarOption id>
         void set_option(details::Setting<T, id> &&setting)
@@ -92,6 +103,7 @@ namespace indicators
             static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
             std::lock_guard<std::mutex> lock(mutex_);
             get_value<id>() = std::move(setting).value;
+            on_option_changed();
         }
 
         template <typename T, details::ProgressBarOption id>
@@ -100,6 +112,7 @@ namespace indicators
             static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
             std::lock_guard<std::mutex> lock(mutex_);
             get_value<id>() = setting.value;
+            on_option_changed();
         }
 
         void set_option( const details::Setting<std::string, details::ProgressBarOption::postfix_text> &setting);
@@ -120,9 +133,25 @@ namespace indicators
         Settings settings_;
         size_t progress_{0};
         size_t index_{0};
-        std::chrono::time_point<std::chrono::high_resolution_clock> start_time_point_;
+        std::chrono::nanoseconds start_time_{0};
         std::mutex mutex_;
 
+        /* Frame buffer reused between renders, so a steady-state frame does not allocate */
+        std::string line_;
+        details::StylePrefix style_;
+        details::RedrawThrottle redraw_throttle_;
+        /* option::Clock, read without the mutex by whoever claims the next frame */
+        std::atomic<const Clock *> clock_{&Clock::steady()};
+
+        std::chrono::nanoseconds now() const { return clock_.load(std::memory_order_acquire)->now(); }
+
+        /*
+            OutputFormat with automatic resolved against the stream, whenever the options change.
+            A spinner has no JSON form and writes plain lines for OutputFormat::json_lines.
+        */
+        OutputFormat output_format_{OutputFormat::terminal};
+        details::PlainLineSchedule plain_schedule_;
+
         template <details::ProgressBarOption id>
         auto get_value() -> decltype((details::get_value<id>(std::declval<Settings &>()).value))
         {
@@ -135,8 +164,20 @@ namespace indicators
             return details::get_value<id>(settings_).value;
         }
 
+        void on_option_changed();
+
+        std::chrono::nanoseconds min_redraw_interval() const;
+
         void save_start_time();
 
+        /* Appends prefix, spinner, percentage, times and postfix to line_ */
+        void compose_row(std::chrono::nanoseconds elapsed);
+
+        /* Read by a PrometheusExporter on its own thread */
+        friend class PrometheusExporter;
+
+        void collect_metrics(details::BarMetrics &metrics);
+
     public:
         void print_progress();
     };
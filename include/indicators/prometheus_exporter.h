@@ -0,0 +1,199 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Prometheus textfile exporter
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_PROMETHEUS_EXPORTER_H
+#define INDICATORS_PROMETHEUS_EXPORTER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <indicators/block_progress_bar.h>
+#include <indicators/dynamic_progress.h>
+#include <indicators/indeterminate_progress_bar.h>
+#include <indicators/multi_progress.h>
+#include <indicators/progress_bar.h>
+#include <indicators/progress_spinner.h>
+#include <indicators/setting.h>
+#include <indicators/details/prometheus_text.h>
+
+namespace indicators
+{
+    /*
+        Writes the progress, MaxProgress, rate, elapsed and remaining time of its
+        bars, as far as each kind of bar has them, as Prometheus gauges to
+        option::ExportPath, every MinRedrawInterval (10 s by default), for the
+        textfile collector of node_exporter. The file is written next to its path
+        and renamed into place, so a reader never sees half of it. Bars are labelled with option::Label, or else their prefix text,
+        with a suffix when an earlier bar has the same label.
+
+        A background thread reads the bars under their mutex, the way a Renderer
+        draws them, so tick() does not get any slower. Stopping the exporter writes
+        the file one last time. Bars have to outlive the exporter.
+    */
+    class PrometheusExporter
+    {
+        using Settings = std::tuple<option::ExportPath, option::MinRedrawInterval>;
+
+    public:
+        template <typename... Args, typename std::enable_if<details::are_settings_from_tuple<Settings, typename std::decay<Args>::type...>::value, void *>::type = nullptr>
+        explicit PrometheusExporter(Args &&... args)
+            : settings_(
+                  details::get<details::ProgressBarOption::export_path>(option::ExportPath{}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::min_redraw_interval>(option::MinRedrawInterval{std::chrono::seconds(10)}, std::forward<Args>(args)...))
+        {
+            thread_ = std::thread(&PrometheusExporter::run, this);
+        }
+
+        PrometheusExporter(const PrometheusExporter &) = delete;
+        PrometheusExporter &operator=(const PrometheusExporter &) = delete;
+
+        ~PrometheusExporter();
+
+        void add(ProgressBar &bar);
+
+        void add(BlockProgressBar &bar);
+
+        /* Exports the elapsed time and completion; the bar has no progress to export */
+        void add(IndeterminateProgressBar &bar);
+
+        /* Exports progress, MaxProgress and completion, and the elapsed time while the spinner shows a time */
+        void add(ProgressSpinner &spinner);
+
+        template <typename Indicator, size_t count>
+        void add(MultiProgress<Indicator, count> &bars);
+
+        /* Rows pushed back later are exported as well */
+        template <typename Indicator>
+        void add(DynamicProgress<Indicator> &bars);
+
+        /* Writes the file now. False if it could not be written. */
+        bool write();
+
+        /* Stops the thread and writes the file a last time. Called by the destructor. */
+        void stop();
+
+        template <typename T, details::ProgressBarOption id>
+        void set_option(details::Setting<T, id> &&setting)
+        {
+            static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                get_value<id>() = std::move(setting).value;
+            }
+            cv_.notify_one();
+        }
+
+        template <typename T, details::ProgressBarOption id>
+        void set_option(const details::Setting<T, id> &setting)
+        {
+            static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                get_value<id>() = setting.value;
+            }
+            cv_.notify_one();
+        }
+
+    private:
+        /* Appends the metrics of one bar, or of every row of a container */
+        using Source = std::function<void(std::vector<details::BarMetrics> &)>;
+
+        Settings settings_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stopping_{false};
+        std::vector<Source> sources_;
+        std::thread thread_;
+
+        /* Reused between writes */
+        std::vector<details::BarMetrics> metrics_;
+        std::string text_;
+
+        template <details::ProgressBarOption id>
+        auto get_value() -> decltype((details::get_value<id>(std::declval<Settings &>()).value))
+        {
+            return details::get_value<id>(settings_).value;
+        }
+
+        void run();
+
+        /* Called with mutex_ held */
+        bool write_file();
+
+        template <typename Indicator>
+        static void collect(Indicator &bar, std::vector<details::BarMetrics> &metrics)
+        {
+            metrics.emplace_back();
+            bar.collect_metrics(metrics.back());
+        }
+    };
+
+    template <typename Indicator, size_t count>
+    void PrometheusExporter::add(MultiProgress<Indicator, count> &bars)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        sources_.push_back([&bars](std::vector<details::BarMetrics> &metrics) {
+            for (auto &bar : bars.bars_)
+            {
+                collect(bar.get(), metrics);
+            }
+        });
+    }
+
+    template <typename Indicator>
+    void PrometheusExporter::add(DynamicProgress<Indicator> &bars)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        sources_.push_back([&bars](std::vector<details::BarMetrics> &metrics) {
+            std::lock_guard<std::mutex> rows_lock{bars.mutex_};
+            for (auto &bar : bars.bars_)
+            {
+                collect(bar.get(), metrics);
+            }
+        });
+    }
+} // namespace indicators
+
+#endif // INDICATORS_PROMETHEUS_EXPORTER_H
@@ -0,0 +1,197 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Background renderer
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_RENDERER_H
+#define INDICATORS_RENDERER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <indicators/dynamic_progress.h>
+#include <indicators/multi_progress.h>
+#include <indicators/progress_bar.h>
+#include <indicators/setting.h>
+
+namespace indicators
+{
+    /*
+        Owns the terminal on behalf of the indicators attached to it. Updates from
+        worker threads then only touch the indicators' atomics, and a background
+        thread draws one frame every MinRedrawInterval (33 ms by default).
+        The thread can be moved off the hot cores with LowPriority and CpuAffinity.
+        Destroying the renderer draws a last frame and hands the indicators back.
+    */
+    class Renderer
+    {
+        using Settings = std::tuple<option::MinRedrawInterval, option::LowPriority, option::CpuAffinity>;
+
+    public:
+        template <typename... Args, typename std::enable_if<details::are_settings_from_tuple<Settings, typename std::decay<Args>::type...>::value, void *>::type = nullptr>
+        explicit Renderer(Args &&... args)
+            : settings_(
+                  details::get<details::ProgressBarOption::min_redraw_interval>(option::MinRedrawInterval{std::chrono::milliseconds(33)}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::low_priority>(option::LowPriority{false}, std::forward<Args>(args)...),
+                  details::get<details::ProgressBarOption::cpu_affinity>(option::CpuAffinity{std::vector<size_t>{}}, std::forward<Args>(args)...))
+        {
+            thread_ = std::thread(&Renderer::run, this);
+        }
+
+        Renderer(const Renderer &) = delete;
+        Renderer &operator=(const Renderer &) = delete;
+
+        ~Renderer();
+
+        void add(ProgressBar &bar);
+
+        template <typename Indicator, size_t count>
+        void add(MultiProgress<Indicator, count> &bars);
+
+        template <typename Indicator>
+        void add(DynamicProgress<Indicator> &bars);
+
+        /* Stops the thread, draws a last frame and detaches all indicators. Called by the destructor. */
+        void stop();
+
+        template <typename T, details::ProgressBarOption id>
+        void set_option(details::Setting<T, id> &&setting)
+        {
+            static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                get_value<id>() = std::move(setting).value;
+                settings_changed_ = true;
+            }
+            cv_.notify_one();
+        }
+
+        template <typename T, details::ProgressBarOption id>
+        void set_option(const details::Setting<T, id> &setting)
+        {
+            static_assert(!std::is_same<T, typename std::decay<decltype(details::get_value<id>(std::declval<Settings>()))>::type>::value, "Setting has wrong type!");
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                get_value<id>() = setting.value;
+                settings_changed_ = true;
+            }
+            cv_.notify_one();
+        }
+
+    private:
+        /* draw() returns true once the indicator has drawn its last frame and can be dropped */
+        struct Target
+        {
+            std::function<bool()> draw;
+            std::function<void()> detach;
+        };
+
+        Settings settings_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stopping_{false};
+        bool settings_changed_{true};
+        std::vector<Target> targets_;
+        std::thread thread_;
+        /* Nice value of the render thread before the LowPriority fallback changed it, restored when turned off */
+        int saved_nice_{0};
+        bool niced_{false};
+        /* CPUs the render thread could run on before CpuAffinity pinned it, restored when cleared */
+        std::vector<size_t> saved_cpus_;
+        bool pinned_{false};
+
+        template <details::ProgressBarOption id>
+        auto get_value() -> decltype((details::get_value<id>(std::declval<Settings &>()).value))
+        {
+            return details::get_value<id>(settings_).value;
+        }
+
+        template <details::ProgressBarOption id>
+        auto get_value() const
+            -> decltype((details::get_value<id>(std::declval<const Settings &>()).value))
+        {
+            return details::get_value<id>(settings_).value;
+        }
+
+        void run();
+
+        void apply_thread_settings();
+
+        void draw_targets(std::vector<Target> &targets);
+
+        void attach(Target &&target);
+    };
+
+    template <typename Indicator, size_t count>
+    void Renderer::add(MultiProgress<Indicator, count> &bars)
+    {
+        bars.renderer_mode_ = true;
+        attach({[&bars]() {
+                    bars.print_progress();
+                    return bars._all_completed();
+                },
+                [&bars]() {
+                    bars.renderer_mode_ = false;
+                    if (bars.drawn_completed_count_ != count)
+                    {
+                        bars.print_progress();
+                    }
+                }});
+    }
+
+    template <typename Indicator>
+    void Renderer::add(DynamicProgress<Indicator> &bars)
+    {
+        bars.renderer_mode_ = true;
+        // Bars can still be pushed back, so the container stays attached until the renderer stops
+        attach({[&bars]() {
+                    bars.print_progress();
+                    return false;
+                },
+                [&bars]() {
+                    bars.renderer_mode_ = false;
+                    bars.print_progress();
+                }});
+    }
+} // namespace indicators
+
+#endif // INDICATORS_RENDERER_H
\ No newline at end of file
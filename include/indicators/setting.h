@@ -40,6 +40,7 @@
 #ifndef INDICATORS_SETTING_H
 #define INDICATORS_SETTING_H
 
+#include <chrono>
 #include <cstddef>
 #include <string>
 #include <tuple>
@@ -47,9 +48,12 @@
 #include <utility>
 #include <vector>
 
+#include <indicators/clock.h>
 #include <indicators/color.h>
 #include <indicators/font_style.h>
+#include <indicators/output_format.h>
 #include <indicators/progress_type.h>
+#include <indicators/details/shared_bar_state.h>
 
 namespace indicators
 {
@@ -139,7 +143,19 @@ namespace indicators
             min_progress,
             max_progress,
             progress_type,
-            stream
+            stream,
+            min_redraw_interval,
+            sharded_progress,
+            low_priority,
+            cpu_affinity,
+            output_format,
+            show_rate,
+            rate_unit,
+            shared_state,
+            socket_path,
+            label,
+            export_path,
+            clock
         };
 
         template <typename T, ProgressBarOption Id>
@@ -285,6 +301,18 @@ namespace indicators
         using MaxProgress = details::IntegerSetting<details::ProgressBarOption::max_progress>;
         using ProgressType = details::Setting<ProgressType, details::ProgressBarOption::progress_type>;
         using Stream = details::Setting<std::ostream &, details::ProgressBarOption::stream>;
+        using MinRedrawInterval = details::Setting<std::chrono::nanoseconds, details::ProgressBarOption::min_redraw_interval>;
+        using ShardedProgress = details::BooleanSetting<details::ProgressBarOption::sharded_progress>;
+        using LowPriority = details::BooleanSetting<details::ProgressBarOption::low_priority>;
+        using CpuAffinity = details::Setting<std::vector<size_t>, details::ProgressBarOption::cpu_affinity>;
+        using OutputFormat = details::Setting<OutputFormat, details::ProgressBarOption::output_format>;
+        using ShowRate = details::BooleanSetting<details::ProgressBarOption::show_rate>;
+        using RateUnit = details::StringSetting<details::ProgressBarOption::rate_unit>;
+        using SharedState = details::Setting<details::SharedBarState *, details::ProgressBarOption::shared_state>;
+        using SocketPath = details::StringSetting<details::ProgressBarOption::socket_path>;
+        using Label = details::StringSetting<details::ProgressBarOption::label>;
+        using ExportPath = details::StringSetting<details::ProgressBarOption::export_path>;
+        using Clock = details::Setting<const Clock *, details::ProgressBarOption::clock>;
 
     } // namespace option
 } // namespace indicators
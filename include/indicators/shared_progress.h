@@ -0,0 +1,105 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Progress shared between processes
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_SHARED_PROGRESS_H
+#define INDICATORS_SHARED_PROGRESS_H
+
+#include <cstddef>
+#include <string>
+
+#include <indicators/details/shared_bar_state.h>
+
+namespace indicators
+{
+    /*
+        A shared memory segment holding the state of `slots` progress bars, for work
+        spread over processes. Pass a slot to a ProgressBar with option::SharedState:
+        workers tick it as usual, but only the process that created the segment draws.
+        That process draws with a Renderer, or by calling print_progress(), since the
+        ticks happen elsewhere.
+
+            indicators::SharedProgress shared{4};
+            indicators::ProgressBar bar{option::MaxProgress{1000}, option::SharedState{shared.slot(0)}};
+            // fork() the workers, which call bar.tick()
+            indicators::Renderer renderer;
+            renderer.add(bar);
+
+        Without a name the mapping is anonymous and reaches the processes forked after
+        it was created. A named segment (POSIX shared memory) is created by the first
+        process and opened by the others, which then only work on it.
+        Shared memory is not available on Windows; there the segment is never valid().
+    */
+    class SharedProgress
+    {
+    public:
+        explicit SharedProgress(size_t slots);
+
+        SharedProgress(const std::string &name, size_t slots);
+
+        SharedProgress(const SharedProgress &) = delete;
+        SharedProgress &operator=(const SharedProgress &) = delete;
+
+        /* Unmaps the segment. A named one is also removed by the process that created it. */
+        ~SharedProgress();
+
+        bool valid() const;
+
+        size_t size() const;
+
+        /* nullptr if the segment is not valid or `index` is out of range, which leaves a bar local */
+        details::SharedBarState *slot(size_t index) const;
+
+    private:
+        struct Header;
+
+        Header *header_{nullptr};
+        size_t mapping_size_{0};
+        std::string name_;
+        long long creator_{0};
+
+        void map_anonymous(size_t slots);
+
+        void map_named(size_t slots);
+
+        /* Called by the process that created the segment, before anyone else can see it */
+        void initialize(size_t slots);
+    };
+} // namespace indicators
+
+#endif // INDICATORS_SHARED_PROGRESS_H
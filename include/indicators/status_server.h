@@ -0,0 +1,180 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Status endpoint on a Unix domain socket
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_STATUS_SERVER_H
+#define INDICATORS_STATUS_SERVER_H
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <indicators/block_progress_bar.h>
+#include <indicators/dynamic_progress.h>
+#include <indicators/indeterminate_progress_bar.h>
+#include <indicators/multi_progress.h>
+#include <indicators/progress_bar.h>
+#include <indicators/setting.h>
+#include <indicators/details/status_cell.h>
+
+namespace indicators
+{
+    /*
+        Serves the progress of a job that may have no terminal at all. Every
+        connection to option::SocketPath (/tmp/indicators-<pid>.sock by default)
+        gets a JSON array with one object per indicator added, the same objects
+        OutputFormat::json_lines writes, and is then closed:
+
+            socat - UNIX-CONNECT:/tmp/indicators-1234.sock
+
+        Indicators publish a snapshot whenever they draw, or try to, so it is as
+        recent as MinRedrawInterval lets it be. The server reads it through a
+        sequence lock without taking any indicator's mutex, so a query never holds
+        up the threads that tick. Indicators have to outlive
+        the server. Unix domain sockets are not used on Windows; there the server
+        is never listening().
+    */
+    class StatusServer : private details::StatusBoard
+    {
+        using Settings = std::tuple<option::SocketPath>;
+
+    public:
+        template <typename... Args, typename std::enable_if<details::are_settings_from_tuple<Settings, typename std::decay<Args>::type...>::value, void *>::type = nullptr>
+        explicit StatusServer(Args &&... args)
+            : settings_(details::get<details::ProgressBarOption::socket_path>(option::SocketPath{}, std::forward<Args>(args)...))
+        {
+            start();
+        }
+
+        StatusServer(const StatusServer &) = delete;
+        StatusServer &operator=(const StatusServer &) = delete;
+
+        ~StatusServer();
+
+        bool listening() const;
+
+        const std::string &path() const;
+
+        void add(ProgressBar &bar);
+
+        void add(BlockProgressBar &bar);
+
+        void add(IndeterminateProgressBar &bar);
+
+        template <typename Indicator, size_t count>
+        void add(MultiProgress<Indicator, count> &bars);
+
+        /* Rows pushed back later are reported as well */
+        template <typename Indicator>
+        void add(DynamicProgress<Indicator> &bars);
+
+        /* Closes the socket and stops the thread. Called by the destructor. */
+        void stop();
+
+    private:
+        Settings settings_;
+        std::string path_;
+        int listen_fd_{-1};
+        int wake_fds_[2]{-1, -1};
+        std::thread thread_;
+
+        /* Guards the cells and detach functions, never taken by an indicator */
+        std::mutex mutex_;
+        std::vector<details::StatusCell *> cells_;
+        std::vector<std::function<void()>> detach_;
+
+        template <details::ProgressBarOption id>
+        auto get_value() -> decltype((details::get_value<id>(std::declval<Settings &>()).value))
+        {
+            return details::get_value<id>(settings_).value;
+        }
+
+        void start();
+
+        void run();
+
+        /* The JSON array a connection is answered with */
+        void compose(std::string &out);
+
+        void add_cell(details::StatusCell &cell) override;
+
+        template <typename Indicator>
+        void add_indicator(Indicator &bar);
+    };
+
+    template <typename Indicator>
+    void StatusServer::add_indicator(Indicator &bar)
+    {
+        details::StatusCell *cell;
+        {
+            std::lock_guard<std::mutex> lock{bar.mutex_};
+            cell = &bar.status_.cell();
+        }
+        add_cell(*cell);
+    }
+
+    template <typename Indicator, size_t count>
+    void StatusServer::add(MultiProgress<Indicator, count> &bars)
+    {
+        for (auto &bar : bars.bars_)
+        {
+            add_indicator(bar.get());
+        }
+    }
+
+    template <typename Indicator>
+    void StatusServer::add(DynamicProgress<Indicator> &bars)
+    {
+        std::lock_guard<std::mutex> lock{bars.mutex_};
+        for (auto &bar : bars.bars_)
+        {
+            add_indicator(bar.get());
+        }
+        bars.status_board_ = this;
+        std::lock_guard<std::mutex> detach_lock{mutex_};
+        detach_.push_back([&bars]() {
+            std::lock_guard<std::mutex> lock{bars.mutex_};
+            bars.status_board_ = nullptr;
+        });
+    }
+} // namespace indicators
+
+#endif // INDICATORS_STATUS_SERVER_H
@@ -86,22 +86,30 @@ namespace termcolor
     namespace _internal
     {
         /*
-            An index to be used to access a private storage of I/O streams. See
-            colorize / nocolorize I/O manipulators for details.
+            Indexes into the private storage of I/O streams: the flag set by the
+            colorize / nocolorize I/O manipulators, and the cached capability.
         */
-        static int colorize_index = std::ios_base::xalloc();
+        int colorize_index();
+        int capability_index();
 
-        inline FILE *get_standard_stream(const std::ostream &stream);
-        inline bool is_colorized(std::ostream &stream);
-        inline bool is_atty(const std::ostream &stream);
+        FILE *get_standard_stream(const std::ostream &stream);
+        bool is_colorized(std::ostream &stream);
+        bool is_atty(const std::ostream &stream);
 
 #if defined(TERMCOLOR_OS_WINDOWS)
-        inline void win_change_attributes(std::ostream &stream, int foreground, int background = -1);
+        void win_change_attributes(std::ostream &stream, int foreground, int background = -1);
 #endif
     } // namespace _internal
 
     std::ostream &colorize(std::ostream &stream);
     std::ostream &nocolorize(std::ostream &stream);
+
+    /*
+        Whether a stream gets colors is resolved once and cached in the stream.
+        Call this after the stream was redirected or NO_COLOR / CLICOLOR_FORCE changed.
+    */
+    void invalidate_capability(std::ostream &stream);
+
     std::ostream &reset(std::ostream &stream);
     std::ostream &bold(std::ostream &stream);
     std::ostream &dark(std::ostream &stream);
@@ -205,9 +213,10 @@ namespace termcolor
         FILE *get_standard_stream(const std::ostream &stream);
 
         /*
-            Say whether a given stream should be colorized or not. It's always
-            true for ATTY streams and may be true for streams marked with
-            colorize flag.
+            Say whether a given stream should be colorized or not: always for
+            streams marked with the colorize flag, never when NO_COLOR is set,
+            always when CLICOLOR_FORCE is set, otherwise when it is a terminal.
+            Resolved on first use and cached until invalidate_capability().
         */
         bool is_colorized(std::ostream &stream);
 
@@ -229,8 +238,4 @@ namespace termcolor
 
 } // namespace termcolor
 
-#undef TERMCOLOR_OS_WINDOWS
-#undef TERMCOLOR_OS_MACOS
-#undef TERMCOLOR_OS_LINUX
-
 #endif // INDICATORS_TERMCOLOR_H
\ No newline at end of file
@@ -47,12 +47,40 @@
 #include <unistd.h>    // for STDOUT_FILENO
 #endif
 
+#include <cstddef>
+#include <ostream>
 #include <utility>
 
 namespace indicators
 {
+    /*
+        Rows and columns of the terminal behind stdout, or behind the standard stream
+        given. Any other stream is measured against stdout. The size is cached and
+        queried again only after a SIGWINCH, or after invalidate_terminal_size(). 80x24
+        is assumed when there is no terminal.
+    */
     std::pair<size_t, size_t> terminal_size();
+    std::pair<size_t, size_t> terminal_size(const std::ostream &stream);
     size_t terminal_width();
+    size_t terminal_width(const std::ostream &stream);
+
+    /*
+        Makes the next terminal_size() ask the terminal again. For an application that
+        handles SIGWINCH itself: the cache notices within a second that its own handler
+        was replaced, and this lets it see the new size at once.
+    */
+    void invalidate_terminal_size();
+
+    /*
+        Makes terminal_size(stream) report the size given rather than ask the system,
+        for streams that are not a terminal of their own, such as a VirtualTerminal.
+        Undone with unpin_terminal_size().
+    */
+    void pin_terminal_size(const std::ostream &stream, size_t rows, size_t cols);
+    void unpin_terminal_size(const std::ostream &stream);
+
+    /* Rows a line drawn `width` columns wide occupies once the terminal has reflowed it to `terminal_width` columns */
+    size_t wrapped_rows(size_t width, size_t terminal_width);
 } // namespace indicators
 
 #endif // INDICATORS_TERMINAL_SIZE_H
\ No newline at end of file
@@ -0,0 +1,186 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Virtual terminal
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#ifndef INDICATORS_VIRTUAL_TERMINAL_H
+#define INDICATORS_VIRTUAL_TERMINAL_H
+
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace indicators
+{
+    /*
+        An ostream that plays the terminal: it interprets what the indicators write
+        (UTF-8 text, \r, \n, cursor movement, erasing, SGR and cursor visibility)
+        into a screen of fixed size, so that tests and benchmarks can check exactly
+        what a user would see. Given to an indicator with option::Stream, it is
+        colorized and reports its own size to terminal_size().
+
+        Every flush ends a frame; frame_bytes() tells what each one cost on the wire.
+        \n moves to the start of the next line, as a tty does, and scrolls at the bottom.
+    */
+    class VirtualTerminal : public std::ostream
+    {
+    public:
+        explicit VirtualTerminal(size_t rows = 24, size_t cols = 80);
+        ~VirtualTerminal();
+
+        VirtualTerminal(const VirtualTerminal &) = delete;
+        VirtualTerminal &operator=(const VirtualTerminal &) = delete;
+
+        size_t rows() const
+        {
+            return rows_;
+        }
+
+        size_t cols() const
+        {
+            return cols_;
+        }
+
+        /* Text of a row, without trailing blanks */
+        std::string row(size_t index) const;
+
+        /* Every row, each ended with \n, without the blank rows at the bottom */
+        std::string screen() const;
+
+        /*
+            SGR parameters a cell was written with, attributes first and colors last,
+            e.g. "1;32"; empty for the default style. Redundant codes do not show.
+        */
+        std::string style(size_t row, size_t col) const;
+
+        /* Rows scrolled off the top, oldest first, without trailing blanks */
+        std::vector<std::string> scrollback() const;
+
+        size_t cursor_row() const;
+        size_t cursor_col() const;
+        bool cursor_visible() const;
+
+        /* Bytes written so far, escapes included */
+        size_t bytes() const;
+
+        /* Bytes of each non-empty flush, in order */
+        std::vector<size_t> frame_bytes() const;
+
+        /* Escape sequences the screen did not understand; a correct frame has none */
+        size_t unknown_sequences() const;
+
+        /* Blank screen, cursor home, counters and scrollback cleared */
+        void clear();
+
+    private:
+        struct Cell
+        {
+            /* UTF-8 of the glyph; empty for the right half of a wide glyph */
+            std::string glyph{" "};
+            std::string style;
+        };
+
+        class Buffer : public std::streambuf
+        {
+        public:
+            explicit Buffer(VirtualTerminal &terminal) : terminal_(terminal) {}
+
+        protected:
+            int_type overflow(int_type ch) override;
+            std::streamsize xsputn(const char *s, std::streamsize n) override;
+            int sync() override;
+
+        private:
+            VirtualTerminal &terminal_;
+        };
+
+        struct Sgr
+        {
+            /* SGR 1 to 9: bold, dim, italic, underline, blink, rapid blink, inverse, hidden, crossed out */
+            bool attributes[10]{};
+            std::string foreground;
+            std::string background;
+        };
+
+        enum class Parse
+        {
+            text,
+            escape,
+            csi
+        };
+
+        /* Called with mutex_ held */
+        void feed(char ch);
+        void put_glyph(const std::string &glyph, int width);
+        void line_feed();
+        void execute_csi(char final);
+        void apply_sgr(const std::vector<int> &params);
+        void erase(size_t row, size_t from, size_t to);
+        void end_frame();
+
+        const size_t rows_;
+        const size_t cols_;
+        Buffer buffer_;
+        mutable std::mutex mutex_;
+
+        std::vector<std::vector<Cell>> screen_;
+        std::vector<std::string> scrollback_;
+        size_t cursor_row_{0};
+        size_t cursor_col_{0};
+        /* Set after a glyph in the last column: the next one starts a new line, \r and cursor moves cancel it */
+        bool wrap_pending_{false};
+        bool cursor_visible_{true};
+        Sgr sgr_;
+        /* sgr_ as parameters, what new cells are written with */
+        std::string style_;
+
+        Parse parse_{Parse::text};
+        std::string csi_;
+        std::string utf8_;
+        size_t utf8_left_{0};
+
+        size_t bytes_{0};
+        size_t frame_start_{0};
+        std::vector<size_t> frame_bytes_;
+        size_t unknown_sequences_{0};
+    };
+} // namespace indicators
+
+#endif // INDICATORS_VIRTUAL_TERMINAL_H
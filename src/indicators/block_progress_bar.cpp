@@ -49,6 +49,9 @@ namespace indicators
         {
             get_value<details::ProgressBarOption::max_postfix_text_len>() = setting.value.length();
         }
+        layout_dirty_ = true;
+        ++layout_version_;
+        row_.mark_dirty();
     }
 
     void BlockProgressBar::set_option(details::Setting<std::string, details::ProgressBarOption::postfix_text> &&setting)
@@ -60,26 +63,77 @@ namespace indicators
         {
             get_value<details::ProgressBarOption::max_postfix_text_len>() = new_value.length();
         }
+        layout_dirty_ = true;
+        ++layout_version_;
+        row_.mark_dirty();
     }
 
     void BlockProgressBar::set_progress(float value)
     {
+        bool completing;
+        std::chrono::nanoseconds min_redraw_interval;
         {
             std::lock_guard<std::mutex> lock{mutex_};
             progress_ = value;
+            completing = progress_ > get_value<details::ProgressBarOption::max_progress>() && !get_value<details::ProgressBarOption::completed>();
+            min_redraw_interval = this->min_redraw_interval();
         }
-        save_start_time();
-        print_progress();
+        on_progress_changed(completing, min_redraw_interval);
     }
 
     void BlockProgressBar::tick()
     {
+        bool completing;
+        std::chrono::nanoseconds min_redraw_interval;
         {
             std::lock_guard<std::mutex> lock{mutex_};
             progress_ += 1;
+            completing = progress_ > get_value<details::ProgressBarOption::max_progress>() && !get_value<details::ProgressBarOption::completed>();
+            min_redraw_interval = this->min_redraw_interval();
         }
+        on_progress_changed(completing, min_redraw_interval);
+    }
+
+    void BlockProgressBar::on_progress_changed(bool completing, std::chrono::nanoseconds min_redraw_interval)
+    {
         save_start_time();
-        print_progress();
+        if (multi_progress_mode_)
+        {
+            // The container draws this bar as one of its rows
+            if (completing)
+            {
+                print_progress();
+            }
+            row_.changed(completing);
+            return;
+        }
+        if (completing || redraw_throttle_.try_claim(min_redraw_interval, now()))
+        {
+            print_progress();
+        }
+    }
+
+    void BlockProgressBar::on_option_changed()
+    {
+        output_format_ = details::resolve_output_format(get_value<details::ProgressBarOption::output_format>(), get_value<details::ProgressBarOption::stream>());
+        clock_.store(get_value<details::ProgressBarOption::clock>() ? get_value<details::ProgressBarOption::clock>() : &Clock::steady(), std::memory_order_release);
+        layout_dirty_ = true;
+        ++layout_version_;
+        row_.mark_dirty();
+    }
+
+    std::chrono::nanoseconds BlockProgressBar::min_redraw_interval() const
+    {
+        const auto min_redraw_interval = get_value<details::ProgressBarOption::min_redraw_interval>();
+        if (output_format_ == OutputFormat::json_lines)
+        {
+            return details::json_line_interval(min_redraw_interval);
+        }
+        if (output_format_ == OutputFormat::plain_lines)
+        {
+            return details::plain_line_interval(min_redraw_interval);
+        }
+        return min_redraw_interval;
     }
 
     size_t BlockProgressBar::current()
@@ -92,53 +146,122 @@ namespace indicators
     {
         get_value<details::ProgressBarOption::completed>() = true;
         print_progress();
+        row_.changed(true);
     }
 
     void BlockProgressBar::save_start_time()
     {
-        auto &show_elapsed_time = get_value<details::ProgressBarOption::show_elapsed_time>();
         auto &saved_start_time = get_value<details::ProgressBarOption::saved_start_time>();
-        auto &show_remaining_time = get_value<details::ProgressBarOption::show_remaining_time>();
-        if ((show_elapsed_time || show_remaining_time) && !saved_start_time)
+        if (!saved_start_time)
         {
-            start_time_point_ = std::chrono::high_resolution_clock::now();
+            start_time_ = now();
             saved_start_time = true;
         }
     }
 
-    std::pair<std::string, size_t> BlockProgressBar::get_prefix_text()
+    void BlockProgressBar::update_layout()
     {
-        std::stringstream os;
-        os << get_value<details::ProgressBarOption::prefix_text>();
-        const auto result = os.str();
-        const auto result_size = unicode::display_width(result);
-        return {result, result_size};
+        style_.set(get_value<details::ProgressBarOption::foreground_color>(), get_value<details::ProgressBarOption::font_styles>());
+        prefix_width_ = unicode::display_width(get_value<details::ProgressBarOption::prefix_text>());
+        postfix_text_width_ = unicode::display_width(get_value<details::ProgressBarOption::postfix_text>());
+        scale_writer_.set_style(get_value<details::ProgressBarOption::bar_width>());
+        layout_dirty_ = false;
     }
 
-    std::pair<std::string, size_t> BlockProgressBar::get_postfix_text()
+    size_t BlockProgressBar::append_prefix_text(std::string &out)
     {
-        std::stringstream os;
-        const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
-        auto now = std::chrono::high_resolution_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_time_point_);
+        out.append(get_value<details::ProgressBarOption::prefix_text>());
+        return prefix_width_;
+    }
+
+    size_t BlockProgressBar::percentage() const
+    {
+        return std::min(static_cast<size_t>(progress_ / get_value<details::ProgressBarOption::max_progress>() * 100.0), size_t(100));
+    }
+
+    std::chrono::nanoseconds BlockProgressBar::update_elapsed()
+    {
+        const auto elapsed = now() - start_time_;
+        if (get_value<details::ProgressBarOption::saved_start_time>() && !get_value<details::ProgressBarOption::completed>())
+        {
+            rate_.sample(std::min(double(progress_), double(get_value<details::ProgressBarOption::max_progress>())), elapsed);
+        }
+        return elapsed;
+    }
+
+    std::chrono::nanoseconds BlockProgressBar::remaining_time(std::chrono::nanoseconds elapsed) const
+    {
+        const auto total = double(get_value<details::ProgressBarOption::max_progress>());
+        const auto done = std::max(0.0, std::min(double(progress_), total));
+        if (done >= total)
+        {
+            return std::chrono::nanoseconds::zero();
+        }
+        if (rate_.has_rate() && rate_.rate() > 0)
+        {
+            // Based on the recent throughput, so a slow start or a stall does not skew it for long
+            return rate_.remaining(total - done);
+        }
+        if (done <= 0)
+        {
+            return std::chrono::nanoseconds::zero();
+        }
+        return std::chrono::nanoseconds(static_cast<long long>(double(elapsed.count()) * (total - done) / done));
+    }
+
+    details::FrameKey BlockProgressBar::frame_key(std::chrono::nanoseconds elapsed, size_t terminal_width) const
+    {
+        details::FrameKey key;
+        key.position = scale_writer_.position(progress_ / get_value<details::ProgressBarOption::max_progress>() * 100);
+        if (get_value<details::ProgressBarOption::show_percentage>())
+        {
+            key.percent = percentage();
+        }
+        if (get_value<details::ProgressBarOption::saved_start_time>())
+        {
+            if (get_value<details::ProgressBarOption::show_elapsed_time>())
+            {
+                key.elapsed_seconds = std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
+            }
+            if (get_value<details::ProgressBarOption::show_remaining_time>())
+            {
+                key.remaining_seconds = std::chrono::duration_cast<std::chrono::seconds>(remaining_time(elapsed)).count();
+            }
+        }
+        if (get_value<details::ProgressBarOption::show_rate>())
+        {
+            const auto rate = details::scale_rate(rate_.rate());
+            key.rate_tenths = rate.tenths;
+            key.rate_prefix = rate.prefix;
+        }
+        key.layout_version = layout_version_;
+        key.terminal_width = terminal_width;
+        return key;
+    }
+
+    size_t BlockProgressBar::append_postfix_text(std::string &out, std::chrono::nanoseconds elapsed)
+    {
+        const auto begin = out.size();
 
         if (get_value<details::ProgressBarOption::show_percentage>())
         {
-            os << " " << std::min(static_cast<size_t>(progress_ / max_progress * 100.0), size_t(100)) << "%";
+            out.push_back(' ');
+            details::append_number(out, percentage());
+            out.push_back('%');
         }
 
         auto &saved_start_time = get_value<details::ProgressBarOption::saved_start_time>();
 
         if (get_value<details::ProgressBarOption::show_elapsed_time>())
         {
-            os << " [";
+            out.append(" [");
             if (saved_start_time)
             {
-                details::write_duration(os, elapsed);
+                elapsed_text_.append(out, elapsed);
             }
             else
             {
-                os << "00:00s";
+                out.append("00:00s");
             }
         }
 
@@ -146,103 +269,266 @@ namespace indicators
         {
             if (get_value<details::ProgressBarOption::show_elapsed_time>())
             {
-                os << "<";
+                out.push_back('<');
             }
             else
             {
-                os << " [";
+                out.append(" [");
             }
 
             if (saved_start_time)
             {
-                auto eta = std::chrono::nanoseconds(
-                    progress_ > 0
-                        ? static_cast<long long>(std::ceil(float(elapsed.count()) *
-                                                           max_progress / progress_))
-                        : 0);
-                auto remaining = eta > elapsed ? (eta - elapsed) : (elapsed - eta);
-                details::write_duration(os, remaining);
+                remaining_text_.append(out, remaining_time(elapsed));
             }
             else
             {
-                os << "00:00s";
+                out.append("00:00s");
             }
 
-            os << "]";
+            out.push_back(']');
         }
         else
         {
             if (get_value<details::ProgressBarOption::show_elapsed_time>())
             {
-                os << "]";
+                out.push_back(']');
             }
         }
 
-        os << " " << get_value<details::ProgressBarOption::postfix_text>();
+        if (get_value<details::ProgressBarOption::show_rate>())
+        {
+            out.push_back(' ');
+            details::append_rate(out, details::scale_rate(rate_.rate()), get_value<details::ProgressBarOption::rate_unit>());
+        }
+
+        out.push_back(' ');
 
-        const auto result = os.str();
-        const auto result_size = unicode::display_width(result);
-        return {result, result_size};
+        // Everything generated above is ASCII, so its display width is its length
+        const auto generated_width = out.size() - begin;
+        out.append(get_value<details::ProgressBarOption::postfix_text>());
+        return generated_width + postfix_text_width_;
     }
 
     void BlockProgressBar::print_progress(bool from_multi_progress)
     {
         std::lock_guard<std::mutex> lock{mutex_};
+        draw_progress(get_value<details::ProgressBarOption::stream>(), from_multi_progress);
+    }
 
-        auto &os = get_value<details::ProgressBarOption::stream>();
+    void BlockProgressBar::print_row(details::FrameStream &frame)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (layout_dirty_)
+        {
+            update_layout();
+        }
+        // The frame tracks the style across rows and writes only what changes
+        frame.set_style(style_);
+        draw_progress(frame, true, frame.terminal_width());
+    }
 
+    void BlockProgressBar::append_json(std::string &out, std::chrono::nanoseconds elapsed)
+    {
         const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
-        if (multi_progress_mode_ && !from_multi_progress)
+        const auto started = get_value<details::ProgressBarOption::saved_start_time>();
+        if (!started)
         {
-            if (progress_ > max_progress)
-            {
-                get_value<details::ProgressBarOption::completed>() = true;
-            }
-            return;
+            elapsed = std::chrono::nanoseconds::zero();
         }
 
-        if (get_value<details::ProgressBarOption::foreground_color>() != Color::unspecified)
+        details::JsonLine json(out);
+        json.field("name", get_value<details::ProgressBarOption::prefix_text>())
+            .field("progress", double(progress_))
+            .field("max", max_progress)
+            .field("percent", percentage())
+            .field("rate", rate_.rate())
+            .field("elapsed", elapsed)
+            .field("eta", started ? remaining_time(elapsed) : std::chrono::nanoseconds::zero())
+            .field("completed", get_value<details::ProgressBarOption::completed>());
+        if (!get_value<details::ProgressBarOption::postfix_text>().empty())
         {
-            details::set_stream_color(os, get_value<details::ProgressBarOption::foreground_color>());
+            json.field("postfix", get_value<details::ProgressBarOption::postfix_text>());
         }
+        json.end();
+    }
 
-        for (auto &style : get_value<details::ProgressBarOption::font_styles>())
+    void BlockProgressBar::publish_status(std::chrono::nanoseconds elapsed)
+    {
+        if (status_.enabled())
         {
-            details::set_font_style(os, style);
+            auto &line = status_.buffer();
+            line.clear();
+            append_json(line, elapsed);
+            status_.publish();
         }
+    }
+
+    void BlockProgressBar::collect_metrics(details::BarMetrics &metrics)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        const auto started = get_value<details::ProgressBarOption::saved_start_time>();
+        // Read only: samples taken on the exporter's schedule would skew the rate the bar shows
+        const auto elapsed = started ? now() - start_time_ : std::chrono::nanoseconds::zero();
+        metrics.label = details::metric_label(get_value<details::ProgressBarOption::label>(), get_value<details::ProgressBarOption::prefix_text>());
+        metrics.progress = double(progress_);
+        metrics.max_progress = double(get_value<details::ProgressBarOption::max_progress>());
+        metrics.rate = rate_.rate();
+        metrics.elapsed = elapsed;
+        metrics.remaining = started ? remaining_time(elapsed) : std::chrono::nanoseconds::zero();
+        metrics.completed = get_value<details::ProgressBarOption::completed>();
+    }
 
-        const auto prefix_pair = get_prefix_text();
-        const auto prefix_text = prefix_pair.first;
-        const auto prefix_length = prefix_pair.second;
-        os << prefix_text;
+    void BlockProgressBar::print_json(std::ostream &os)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        const auto elapsed = update_elapsed();
+        publish_status(elapsed);
+        line_.clear();
+        append_json(line_, elapsed);
+        os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+    }
 
-        os << get_value<details::ProgressBarOption::start>();
+    size_t BlockProgressBar::compose_row(std::chrono::nanoseconds elapsed)
+    {
+        const auto prefix_length = append_prefix_text(line_);
 
-        details::BlockProgressScaleWriter writer{os, get_value<details::ProgressBarOption::bar_width>()};
-        writer.write(progress_ / max_progress * 100);
+        line_.append(get_value<details::ProgressBarOption::start>());
 
-        os << get_value<details::ProgressBarOption::end>();
+        scale_writer_.write(line_, progress_ / get_value<details::ProgressBarOption::max_progress>() * 100);
 
-        const auto postfix_pair = get_postfix_text();
-        const auto postfix_text = postfix_pair.first;
-        const auto postfix_length = postfix_pair.second;
-        os << postfix_text;
+        line_.append(get_value<details::ProgressBarOption::end>());
+
+        const auto postfix_length = append_postfix_text(line_, elapsed);
 
         // Get length of prefix text and postfix text
         const auto start_length = get_value<details::ProgressBarOption::start>().size();
         const auto bar_width = get_value<details::ProgressBarOption::bar_width>();
         const auto end_length = get_value<details::ProgressBarOption::end>().size();
-        const auto terminal_width = terminal_size().second;
+        return prefix_length + start_length + bar_width + end_length + postfix_length;
+    }
+
+    void BlockProgressBar::write_plain_line(std::ostream &os, std::chrono::nanoseconds elapsed, bool final)
+    {
+        if (!plain_schedule_.due(percentage(), final, now()))
+        {
+            return;
+        }
+        if (layout_dirty_)
+        {
+            update_layout();
+        }
+        line_.clear();
+        compose_row(elapsed);
+        details::end_plain_line(line_);
+        os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+        os.flush();
+    }
+
+    void BlockProgressBar::print_plain(std::ostream &os)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        const auto final = progress_ > get_value<details::ProgressBarOption::max_progress>() || get_value<details::ProgressBarOption::completed>();
+        const auto elapsed = update_elapsed();
+        publish_status(elapsed);
+        write_plain_line(os, elapsed, final);
+    }
+
+    bool BlockProgressBar::take_row_dirty()
+    {
+        if (row_.take_dirty())
+        {
+            return true;
+        }
+        // Elapsed and remaining time move on while the progress does not
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (!(get_value<details::ProgressBarOption::show_elapsed_time>() || get_value<details::ProgressBarOption::show_remaining_time>() ||
+              get_value<details::ProgressBarOption::show_rate>()) ||
+            !get_value<details::ProgressBarOption::saved_start_time>() || get_value<details::ProgressBarOption::completed>())
+        {
+            return false;
+        }
+        const auto elapsed = now() - start_time_;
+        return std::chrono::duration_cast<std::chrono::seconds>(elapsed).count() != row_second_;
+    }
+
+    void BlockProgressBar::draw_progress(std::ostream &os, bool from_multi_progress)
+    {
+        draw_progress(os, from_multi_progress, terminal_size(os).second);
+    }
+
+    void BlockProgressBar::draw_progress(std::ostream &os, bool from_multi_progress, size_t terminal_width)
+    {
+        const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
+        if (multi_progress_mode_ && !from_multi_progress)
+        {
+            if (progress_ > max_progress)
+            {
+                get_value<details::ProgressBarOption::completed>() = true;
+            }
+            return;
+        }
+
+        if (layout_dirty_)
+        {
+            update_layout();
+        }
+
+        const auto elapsed = update_elapsed();
+        const auto finishing = progress_ > max_progress || get_value<details::ProgressBarOption::completed>();
+        publish_status(elapsed);
+        if (!from_multi_progress)
+        {
+            // MultiProgress redraws every row after moving the cursor, and the last frame is always written
+            const auto key = frame_key(elapsed, terminal_width);
+            if (key == drawn_key_ && !finishing)
+            {
+                return;
+            }
+            drawn_key_ = key;
+        }
+        else
+        {
+            row_second_ = std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
+        }
+
+        if (output_format_ != OutputFormat::terminal && !from_multi_progress)
+        {
+            if (progress_ > max_progress)
+            {
+                get_value<details::ProgressBarOption::completed>() = true;
+            }
+            if (output_format_ == OutputFormat::json_lines)
+            {
+                line_.clear();
+                append_json(line_, elapsed);
+                os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+                os.flush();
+            }
+            else
+            {
+                write_plain_line(os, elapsed, finishing);
+            }
+            return;
+        }
+
+        line_.clear();
+        if (!from_multi_progress)
+        {
+            style_.append(line_, os);
+        }
+
         // prefix + bar_width + postfix should be <= terminal_width
-        const int remaining = terminal_width - (prefix_length + start_length + bar_width + end_length + postfix_length);
+        const int remaining = terminal_width - compose_row(elapsed);
         if (remaining > 0)
         {
-            os << std::string(remaining, ' ') << "\r";
+            line_.append(remaining, ' ');
+            line_.push_back('\r');
         }
         else if (remaining < 0)
         {
             // Do nothing. Maybe in the future truncate postfix with ...
         }
+        os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
         os.flush();
 
         if (progress_ > max_progress)
@@ -0,0 +1,80 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Clock
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/clock.h"
+
+namespace indicators
+{
+    namespace
+    {
+        class SteadyClock : public Clock
+        {
+        public:
+            std::chrono::nanoseconds now() const override
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+            }
+        };
+    } // namespace
+
+    const Clock &Clock::steady()
+    {
+        static const SteadyClock clock;
+        return clock;
+    }
+
+    ManualClock::ManualClock(std::chrono::nanoseconds start) : now_ns_(start.count())
+    {
+    }
+
+    std::chrono::nanoseconds ManualClock::now() const
+    {
+        return std::chrono::nanoseconds(now_ns_.load(std::memory_order_acquire));
+    }
+
+    void ManualClock::advance(std::chrono::nanoseconds duration)
+    {
+        now_ns_.fetch_add(duration.count(), std::memory_order_acq_rel);
+    }
+
+    void ManualClock::set(std::chrono::nanoseconds time)
+    {
+        now_ns_.store(time.count(), std::memory_order_release);
+    }
+} // namespace indicators
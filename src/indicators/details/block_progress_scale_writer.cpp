@@ -43,29 +43,42 @@ namespace indicators
 {
     namespace details
     {
-        std::ostream &BlockProgressScaleWriter::write(float progress)
+        void BlockProgressScaleWriter::set_style(size_t bar_width)
         {
-            std::string fill_text{"█"};
-            std::vector<std::string> lead_characters{" ", "▏", "▎", "▍", "▌", "▋", "▊", "▉"};
+            this->bar_width = bar_width;
+            fill.assign("█", bar_width);
+        }
+
+        void BlockProgressScaleWriter::write(std::string &out, float progress) const
+        {
+            static const char *const lead_characters[] = {" ", "▏", "▎", "▍", "▌", "▋", "▊", "▉"};
+            const size_t lead_characters_size = sizeof(lead_characters) / sizeof(lead_characters[0]);
             auto value = std::min(1.0f, std::max(0.0f, progress / 100.0f));
             auto whole_width = std::floor(value * bar_width);
             auto remainder_width = fmod((value * bar_width), 1.0f);
-            auto part_width = std::floor(remainder_width * lead_characters.size());
-            std::string lead_text = lead_characters[size_t(part_width)];
+            auto part_width = std::floor(remainder_width * lead_characters_size);
+            const char *lead_text = lead_characters[size_t(part_width)];
             if ((bar_width - whole_width - 1) < 0)
             {
                 lead_text = "";
             }
-            for (size_t i = 0; i < whole_width; ++i)
+            fill.append(out, static_cast<size_t>(whole_width));
+            out.append(lead_text);
+            if (bar_width - whole_width - 1 > 0)
             {
-                os << fill_text;
+                out.append(static_cast<size_t>(bar_width - whole_width - 1), ' ');
             }
-            os << lead_text;
-            for (size_t i = 0; i < (bar_width - whole_width - 1); ++i)
-            {
-                os << " ";
-            }
-            return os;
+        }
+
+        size_t BlockProgressScaleWriter::position(float progress) const
+        {
+            // Same arithmetic as write(), so that equal positions render equal bars
+            const size_t lead_characters_size = 8;
+            auto value = std::min(1.0f, std::max(0.0f, progress / 100.0f));
+            auto whole_width = std::floor(value * bar_width);
+            auto remainder_width = fmod((value * bar_width), 1.0f);
+            auto part_width = std::floor(remainder_width * lead_characters_size);
+            return static_cast<size_t>(whole_width) * lead_characters_size + static_cast<size_t>(part_width);
         }
     } // namespace details
 } // namespace indicators
\ No newline at end of file
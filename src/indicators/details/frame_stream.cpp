@@ -0,0 +1,274 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Frame stream
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/details/frame_stream.h"
+
+#include <indicators/display_width.h>
+#include <indicators/termcolor.h>
+#include <indicators/terminal_size.h>
+#include <indicators/details/stream_helper.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace indicators
+{
+    namespace details
+    {
+        namespace
+        {
+            /* The buffers the standard streams start out with */
+            std::streambuf *const cout_buffer = std::cout.rdbuf();
+            std::streambuf *const cerr_buffer = std::cerr.rdbuf();
+            std::streambuf *const clog_buffer = std::clog.rdbuf();
+
+            /* Whether the stream still writes to its file, and not to a buffer it was redirected to */
+            bool has_standard_buffer(const std::ostream &os)
+            {
+                if (&os == &std::cout)
+                {
+                    return os.rdbuf() == cout_buffer;
+                }
+                if (&os == &std::cerr)
+                {
+                    return os.rdbuf() == cerr_buffer;
+                }
+                if (&os == &std::clog)
+                {
+                    return os.rdbuf() == clog_buffer;
+                }
+                return false;
+            }
+
+            bool is_control(unsigned char c)
+            {
+                return c < 0x20 || c == 0x7f;
+            }
+
+            /* Index past the escape sequence starting at `begin`: a CSI up to its final byte, else ESC and one more byte */
+            size_t skip_escape(const std::string &text, size_t begin)
+            {
+                auto i = begin + 1;
+                if (i < text.size() && text[i] == '[')
+                {
+                    ++i;
+                    while (i < text.size() && (text[i] < 0x40 || text[i] > 0x7e))
+                    {
+                        ++i;
+                    }
+                }
+                return std::min(i + 1, text.size());
+            }
+        } // namespace
+
+        FrameStream::FrameStream() : std::ostream(nullptr)
+        {
+            rdbuf(&buffer_);
+        }
+
+        void FrameStream::reset(std::ostream &target)
+        {
+            buffer_.text.clear();
+            clear();
+            sgr_.clear();
+            colorized_ = termcolor::_internal::is_colorized(target);
+            terminal_width_ = indicators::terminal_width(target);
+            if (colorized_)
+            {
+                *this << termcolor::colorize;
+            }
+            else
+            {
+                *this << termcolor::nocolorize;
+            }
+        }
+
+        void FrameStream::set_style(const StylePrefix &style)
+        {
+#if defined(_WIN32)
+            // Windows consoles take colors through termcolor calls, which a frame cannot carry
+            (void)style;
+#else
+            if (!colorized_ || style.codes() == sgr_)
+            {
+                return;
+            }
+            auto &text = buffer_.text;
+            text.append("\033[");
+            if (!sgr_.empty())
+            {
+                // Reset first, so no attribute of the previous style is left
+                text.append(style.codes().empty() ? "0" : "0;");
+            }
+            text.append(style.codes());
+            text.push_back('m');
+            sgr_ = style.codes();
+#endif
+        }
+
+        void FrameStream::clear_style()
+        {
+            if (!sgr_.empty())
+            {
+                buffer_.text.append("\033[0m");
+                sgr_.clear();
+            }
+        }
+
+        FrameStream::Buffer::int_type FrameStream::Buffer::overflow(int_type ch)
+        {
+            if (!traits_type::eq_int_type(ch, traits_type::eof()))
+            {
+                text.push_back(traits_type::to_char_type(ch));
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        std::streamsize FrameStream::Buffer::xsputn(const char *s, std::streamsize n)
+        {
+            text.append(s, static_cast<size_t>(n));
+            return n;
+        }
+
+        size_t FrameStream::columns_since(size_t offset) const
+        {
+            const auto &text = buffer_.text;
+            size_t widest = 0;
+            size_t column = 0;
+            auto i = offset;
+            while (i < text.size())
+            {
+                const auto c = static_cast<unsigned char>(text[i]);
+                if (c == 0x1b)
+                {
+                    i = skip_escape(text, i);
+                    continue;
+                }
+                if (is_control(c))
+                {
+                    if (c == '\r' || c == '\n')
+                    {
+                        column = 0;
+                    }
+                    ++i;
+                    continue;
+                }
+                auto end = i + 1;
+                while (end < text.size() && !is_control(static_cast<unsigned char>(text[end])))
+                {
+                    ++end;
+                }
+                column += static_cast<size_t>(std::max(unicode::display_width(text.data() + i, end - i), 0));
+                widest = std::max(widest, column);
+                i = end;
+            }
+            return widest;
+        }
+
+        void append_cursor_up(std::string &out, size_t lines)
+        {
+            if (lines == 0)
+            {
+                return;
+            }
+            out.append("\033[");
+            append_number(out, lines);
+            out.push_back('A');
+        }
+
+        void append_cursor_down(std::string &out, size_t lines)
+        {
+            if (lines == 0)
+            {
+                return;
+            }
+            out.append("\033[");
+            append_number(out, lines);
+            out.push_back('B');
+        }
+
+        void write_frame(std::ostream &os, const std::string &frame)
+        {
+            FILE *file = termcolor::_internal::get_standard_stream(os);
+            if (!file || !has_standard_buffer(os))
+            {
+                os.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+                os.flush();
+                return;
+            }
+
+            // Whatever was streamed before the frame has to reach the terminal first
+            os.flush();
+            std::fflush(file);
+#if defined(_WIN32)
+            const int fd = _fileno(file);
+#else
+            const int fd = fileno(file);
+#endif
+            const char *data = frame.data();
+            size_t left = frame.size();
+            while (left > 0)
+            {
+#if defined(_WIN32)
+                const auto written = _write(fd, data, static_cast<unsigned int>(left));
+#else
+                const auto written = ::write(fd, data, left);
+#endif
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return;
+                }
+                data += written;
+                left -= static_cast<size_t>(written);
+            }
+        }
+    } // namespace details
+} // namespace indicators
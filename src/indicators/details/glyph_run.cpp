@@ -33,42 +33,34 @@
 
 /**
  * @file
- * @brief Multi progress
- * @author Pranav, SavaLione
- * @date 29 Dec 2020
+ * @brief Glyph run
+ * @author SavaLione
+ * @date 16 Oct 2026
  */
-#include "indicators/multi_progress.h"
+#include "indicators/details/glyph_run.h"
+
+#include <indicators/display_width.h>
 
 namespace indicators
 {
-    template <typename Indicator, size_t count>
-    bool MultiProgress<Indicator, count>::_all_completed()
-    {
-        bool result{true};
-        for (size_t i = 0; i < count; ++i)
-        {
-            result &= bars_[i].get().is_completed();
-        }
-        return result;
-    }
-
-    template <typename Indicator, size_t count>
-    void MultiProgress<Indicator, count>::print_progress()
+    namespace details
     {
-        std::lock_guard<std::mutex> lock{mutex_};
-        if (started_)
-        {
-            move_up(count);
-        }
-        for (auto &bar : bars_)
-        {
-            bar.get().print_progress(true);
-            std::cout << "\n";
-        }
-        std::cout << termcolor::reset;
-        if (!started_)
+        void GlyphRun::assign(const std::string &glyph, size_t columns)
         {
-            started_ = true;
+            const int width = unicode::display_width(glyph);
+            glyph_ = glyph;
+            glyph_size_ = glyph.size();
+            width_ = width > 0 ? static_cast<size_t>(width) : 0;
+            run_.clear();
+            if (width_ > 0)
+            {
+                const auto count = columns / width_;
+                run_.reserve(count * glyph_size_);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    run_.append(glyph);
+                }
+            }
         }
-    }
+    } // namespace details
 } // namespace indicators
\ No newline at end of file
@@ -43,42 +43,41 @@ namespace indicators
 {
     namespace details
     {
-        std::ostream &IndeterminateProgressScaleWriter::write(size_t progress)
+        void IndeterminateProgressScaleWriter::set_style(size_t bar_width, const std::string &fill, const std::string &lead)
         {
-            for (size_t i = 0; i < bar_width;)
-            {
-                std::string next;
-                size_t current_display_width = 0;
+            this->bar_width = bar_width;
+            this->fill.assign(fill, bar_width);
+            this->lead = lead;
+            lead_width = std::max(0, unicode::display_width(lead));
+        }
 
-                if (i < progress)
-                {
-                    next = fill;
-                    current_display_width = unicode::display_width(fill);
-                }
-                else if (i == progress)
-                {
-                    next = lead;
-                    current_display_width = unicode::display_width(lead);
-                }
-                else
+        void IndeterminateProgressScaleWriter::write(std::string &out, size_t progress) const
+        {
+            // The lead is drawn only where a fill glyph boundary lands exactly on progress
+            size_t column = 0;
+            if (progress < bar_width && (progress == 0 || (fill.width() > 0 && progress % fill.width() == 0)))
+            {
+                fill.append(out, progress / std::max<size_t>(fill.width(), 1));
+                if (lead_width == 0)
                 {
-                    next = fill;
-                    current_display_width = unicode::display_width(fill);
+                    // zero-width glyph would never advance the cursor
+                    return;
                 }
-
-                i += current_display_width;
-
-                if (i > bar_width)
+                if (progress + lead_width > bar_width)
                 {
-                    // `next` is larger than the allowed bar width
-                    // fill with empty space instead
-                    os << std::string((bar_width - (i - current_display_width)), ' ');
-                    break;
+                    out.append(bar_width - progress, ' ');
+                    return;
                 }
+                out.append(lead);
+                column = progress + lead_width;
+            }
 
-                os << next;
+            if (column < bar_width && fill.width() > 0)
+            {
+                const auto count = (bar_width - column) / fill.width();
+                fill.append(out, count);
+                out.append(bar_width - column - count * fill.width(), ' ');
             }
-            return os;
         }
     } // namespace details
 } // namespace indicators
\ No newline at end of file
@@ -0,0 +1,148 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief JSON line
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/details/json_line.h"
+
+#include <indicators/details/stream_helper.h>
+
+#include <cmath>
+
+namespace indicators
+{
+    namespace details
+    {
+        JsonLine::JsonLine(std::string &out) : out_(out)
+        {
+            out_.push_back('{');
+        }
+
+        void JsonLine::key(const char *name)
+        {
+            if (!first_)
+            {
+                out_.push_back(',');
+            }
+            first_ = false;
+            out_.push_back('"');
+            out_.append(name);
+            out_.append("\":");
+        }
+
+        JsonLine &JsonLine::field(const char *name, const std::string &value)
+        {
+            static const char hex[] = "0123456789abcdef";
+            key(name);
+            out_.push_back('"');
+            for (const auto c : value)
+            {
+                const auto byte = static_cast<unsigned char>(c);
+                if (c == '"' || c == '\\')
+                {
+                    out_.push_back('\\');
+                    out_.push_back(c);
+                }
+                else if (byte < 0x20)
+                {
+                    out_.append("\\u00");
+                    out_.push_back(hex[byte >> 4]);
+                    out_.push_back(hex[byte & 0xf]);
+                }
+                else
+                {
+                    out_.push_back(c);
+                }
+            }
+            out_.push_back('"');
+            return *this;
+        }
+
+        JsonLine &JsonLine::field(const char *name, size_t value)
+        {
+            key(name);
+            append_number(out_, value);
+            return *this;
+        }
+
+        JsonLine &JsonLine::field(const char *name, bool value)
+        {
+            key(name);
+            out_.append(value ? "true" : "false");
+            return *this;
+        }
+
+        JsonLine &JsonLine::field(const char *name, double value)
+        {
+            key(name);
+            if (!std::isfinite(value))
+            {
+                out_.append("null");
+                return *this;
+            }
+            if (value < 0)
+            {
+                out_.push_back('-');
+                value = -value;
+            }
+            const auto tenths = static_cast<size_t>(std::llround(value * 10));
+            append_number(out_, tenths / 10);
+            out_.push_back('.');
+            append_number(out_, tenths % 10);
+            return *this;
+        }
+
+        JsonLine &JsonLine::field(const char *name, std::chrono::nanoseconds value)
+        {
+            return field(name, std::chrono::duration<double>(value).count());
+        }
+
+        void JsonLine::end()
+        {
+            out_.append("}\n");
+        }
+
+        std::chrono::nanoseconds json_line_interval(std::chrono::nanoseconds min_redraw_interval)
+        {
+            if (min_redraw_interval.count() > 0)
+            {
+                return min_redraw_interval;
+            }
+            return std::chrono::seconds(1);
+        }
+    } // namespace details
+} // namespace indicators
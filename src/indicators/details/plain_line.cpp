@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Plain line
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/details/plain_line.h"
+
+#include <indicators/termcolor.h>
+
+#include <algorithm>
+
+namespace indicators
+{
+    namespace details
+    {
+        namespace
+        {
+            const std::chrono::seconds plain_line_period{10};
+            const size_t plain_line_percent_step = 10;
+        } // namespace
+
+        OutputFormat resolve_output_format(OutputFormat format, std::ostream &os)
+        {
+            if (format != OutputFormat::automatic)
+            {
+                return format;
+            }
+            // Not is_colorized(): NO_COLOR drops the colors, not the frames
+            const auto forced = os.iword(termcolor::_internal::colorize_index()) != 0;
+            return forced || termcolor::_internal::is_atty(os) ? OutputFormat::terminal : OutputFormat::plain_lines;
+        }
+
+        std::chrono::nanoseconds plain_line_interval(std::chrono::nanoseconds min_redraw_interval)
+        {
+            return std::max<std::chrono::nanoseconds>(min_redraw_interval, std::chrono::milliseconds(100));
+        }
+
+        void end_plain_line(std::string &line)
+        {
+            const auto end = line.find_last_not_of(' ');
+            line.erase(end == std::string::npos ? 0 : end + 1);
+            line.push_back('\n');
+        }
+
+        bool PlainLineSchedule::due(size_t percent, bool final, std::chrono::nanoseconds now)
+        {
+            if (finished_)
+            {
+                return false;
+            }
+            const auto step = percent / plain_line_percent_step;
+            // Reaching 100 percent is left to the final line
+            const auto crossed = step != step_ && percent < 100;
+            if (final || !started_ || crossed || now - written_at_ >= plain_line_period)
+            {
+                written_at_ = now;
+                step_ = step;
+                started_ = true;
+                finished_ = final;
+                return true;
+            }
+            return false;
+        }
+    } // namespace details
+} // namespace indicators
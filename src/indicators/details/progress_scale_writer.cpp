@@ -43,42 +43,65 @@ namespace indicators
 {
     namespace details
     {
-        std::ostream &ProgressScaleWriter::write(float progress)
+        void ProgressScaleWriter::set_style(size_t bar_width, const std::string &fill, const std::string &lead, const std::string &remainder)
         {
-            auto pos = static_cast<size_t>(progress * bar_width / 100.0);
-            for (size_t i = 0, current_display_width = 0; i < bar_width;)
-            {
-                std::string next;
+            this->bar_width = bar_width;
+            this->fill.assign(fill, bar_width);
+            this->lead = lead;
+            lead_width = std::max(0, unicode::display_width(lead));
+            this->remainder.assign(remainder, bar_width);
+        }
 
-                if (i < pos)
-                {
-                    next = fill;
-                    current_display_width = unicode::display_width(fill);
-                }
-                else if (i == pos)
+        void ProgressScaleWriter::write(std::string &out, float progress) const
+        {
+            /*
+                Fill glyphs while the column is before pos, the lead if a glyph boundary lands
+                exactly on pos, then remainder glyphs. A glyph that would cross bar_width is
+                replaced by spaces.
+            */
+            const auto pos = position(progress);
+            size_t column = 0;
+
+            if (pos > 0 && bar_width > 0)
+            {
+                if (fill.width() == 0)
                 {
-                    next = lead;
-                    current_display_width = unicode::display_width(lead);
+                    // zero-width glyph would never advance the cursor
+                    return;
                 }
-                else
+                const auto count = (std::min(pos, bar_width) + fill.width() - 1) / fill.width();
+                if (count * fill.width() > bar_width)
                 {
-                    next = remainder;
-                    current_display_width = unicode::display_width(remainder);
+                    fill.append(out, bar_width / fill.width());
+                    out.append(bar_width % fill.width(), ' ');
+                    return;
                 }
+                fill.append(out, count);
+                column = count * fill.width();
+            }
 
-                i += current_display_width;
-
-                if (i > bar_width)
+            if (column == pos && column < bar_width)
+            {
+                if (column + lead_width > bar_width)
                 {
-                    // `next` is larger than the allowed bar width
-                    // fill with empty space instead
-                    os << std::string((bar_width - (i - current_display_width)), ' ');
-                    break;
+                    out.append(bar_width - column, ' ');
+                    return;
                 }
+                out.append(lead);
+                column += lead_width;
+            }
 
-                os << next;
+            if (column < bar_width && remainder.width() > 0)
+            {
+                const auto count = (bar_width - column) / remainder.width();
+                remainder.append(out, count);
+                out.append(bar_width - column - count * remainder.width(), ' ');
             }
-            return os;
+        }
+
+        size_t ProgressScaleWriter::position(float progress) const
+        {
+            return static_cast<size_t>(progress * bar_width / 100.0);
         }
     } // namespace details
 } // namespace indicators
\ No newline at end of file
@@ -0,0 +1,188 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Prometheus text format
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/details/prometheus_text.h"
+
+#include <cmath>
+#include <cstdio>
+#include <set>
+
+namespace indicators
+{
+    namespace details
+    {
+        namespace
+        {
+            void append_label_value(std::string &out, const std::string &value)
+            {
+                for (const auto c : value)
+                {
+                    if (c == '\\' || c == '"')
+                    {
+                        out.push_back('\\');
+                        out.push_back(c);
+                    }
+                    else if (c == '\n')
+                    {
+                        out.append("\\n");
+                    }
+                    else
+                    {
+                        out.push_back(c);
+                    }
+                }
+            }
+
+            void append_value(std::string &out, double value)
+            {
+                if (std::isnan(value))
+                {
+                    out.append("NaN");
+                    return;
+                }
+                if (std::isinf(value))
+                {
+                    out.append(value > 0 ? "+Inf" : "-Inf");
+                    return;
+                }
+                char buffer[32];
+                const auto length = std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+                out.append(buffer, static_cast<size_t>(length));
+            }
+
+            bool always(const BarMetrics &)
+            {
+                return true;
+            }
+
+            bool has_progress(const BarMetrics &bar)
+            {
+                return bar.has_progress;
+            }
+
+            bool has_rate(const BarMetrics &bar)
+            {
+                return bar.has_rate;
+            }
+
+            template <typename Value>
+            void append_family(std::string &out, const char *name, const char *help, const std::vector<BarMetrics> &bars, Value value,
+                               bool (*present)(const BarMetrics &))
+            {
+                out.append("# HELP ").append(name).push_back(' ');
+                out.append(help).push_back('\n');
+                out.append("# TYPE ").append(name).append(" gauge\n");
+                for (const auto &bar : bars)
+                {
+                    if (!present(bar))
+                    {
+                        continue;
+                    }
+                    out.append(name).append("{bar=\"");
+                    append_label_value(out, bar.label);
+                    out.append("\"} ");
+                    append_value(out, value(bar));
+                    out.push_back('\n');
+                }
+            }
+        } // namespace
+
+        std::string metric_label(const std::string &label, const std::string &prefix_text)
+        {
+            if (!label.empty())
+            {
+                return label;
+            }
+            const auto begin = prefix_text.find_first_not_of(' ');
+            if (begin == std::string::npos)
+            {
+                return std::string();
+            }
+            return prefix_text.substr(begin, prefix_text.find_last_not_of(' ') - begin + 1);
+        }
+
+        void make_labels_unique(std::vector<BarMetrics> &bars)
+        {
+            // Suffixed labels stay clear of the labels later bars were given
+            std::set<std::string> given;
+            for (const auto &bar : bars)
+            {
+                given.insert(bar.label);
+            }
+            std::set<std::string> used;
+            for (auto &bar : bars)
+            {
+                if (bar.label.empty())
+                {
+                    bar.label = "bar";
+                }
+                if (used.count(bar.label) != 0)
+                {
+                    const auto base = bar.label;
+                    for (size_t n = 2;; ++n)
+                    {
+                        bar.label = base + "_" + std::to_string(n);
+                        if (used.count(bar.label) == 0 && given.count(bar.label) == 0)
+                        {
+                            break;
+                        }
+                    }
+                }
+                used.insert(bar.label);
+            }
+        }
+
+        void append_prometheus(std::string &out, const std::vector<BarMetrics> &bars)
+        {
+            // Samples of a family have to be consecutive, so the bars are walked once per family
+            append_family(out, "indicators_progress", "Current progress of the bar.", bars,
+                          [](const BarMetrics &bar) { return bar.progress; }, has_progress);
+            append_family(out, "indicators_max_progress", "Progress at which the bar completes.", bars,
+                          [](const BarMetrics &bar) { return bar.max_progress; }, has_progress);
+            append_family(out, "indicators_rate", "Recent throughput in units per second.", bars,
+                          [](const BarMetrics &bar) { return bar.rate; }, has_rate);
+            append_family(out, "indicators_elapsed_seconds", "Time since the bar started.", bars,
+                          [](const BarMetrics &bar) { return std::chrono::duration<double>(bar.elapsed).count(); }, always);
+            append_family(out, "indicators_eta_seconds", "Estimated time until the bar completes.", bars,
+                          [](const BarMetrics &bar) { return std::chrono::duration<double>(bar.remaining).count(); }, has_rate);
+            append_family(out, "indicators_completed", "Whether the bar has completed.", bars,
+                          [](const BarMetrics &bar) { return bar.completed ? 1.0 : 0.0; }, always);
+        }
+    } // namespace details
+} // namespace indicators
@@ -33,74 +33,62 @@
 
 /**
  * @file
- * @brief Dynamic progress
- * @author Pranav, SavaLione
- * @date 28 Dec 2020
+ * @brief Rate estimator
+ * @author SavaLione
+ * @date 16 Oct 2026
  */
-#include "indicators/dynamic_progress.h"
+#include "indicators/details/rate_estimator.h"
+
+#include <algorithm>
+#include <cmath>
 
 namespace indicators
 {
-    template <typename Indicator>
-    size_t DynamicProgress<Indicator>::push_back(Indicator &bar)
+    namespace details
     {
-        std::lock_guard<std::mutex> lock{mutex_};
-        bar.multi_progress_mode_ = true;
-        bars_.push_back(bar);
-        return bars_.size() - 1;
-    }
+        namespace
+        {
+            /* Seconds after which a rate has faded to 1/e of its weight */
+            const double time_constant = 5.0;
+            /* Samples closer than this are merged into the next one */
+            const std::chrono::milliseconds min_sample_interval{100};
+        } // namespace
 
-    template <typename Indicator>
-    void DynamicProgress<Indicator>::print_progress()
-    {
-        std::lock_guard<std::mutex> lock{mutex_};
-        auto &hide_bar_when_complete = get_value<details::ProgressBarOption::hide_bar_when_complete>();
-        if (hide_bar_when_complete)
+        void RateEstimator::sample(double work, std::chrono::nanoseconds elapsed)
         {
-            // Hide completed bars
-            if (started_)
-            {
-                for (size_t i = 0; i < incomplete_count_; ++i)
-                {
-                    std::cout << "\033[A\r\033[K" << std::flush;
-                }
-            }
-            incomplete_count_ = 0;
-            for (auto &bar : bars_)
-            {
-                if (!bar.get().is_completed())
-                {
-                    bar.get().print_progress(true);
-                    std::cout << "\n";
-                    ++incomplete_count_;
-                }
-            }
-            if (!started_)
+            if (!started_ || work < last_work_ || elapsed < last_elapsed_)
             {
+                // The first sample, or a bar that was set back, only sets the baseline
+                last_work_ = work;
+                last_elapsed_ = elapsed;
                 started_ = true;
+                return;
             }
-        }
-        else
-        {
-            // Don't hide any bars
-            if (started_)
+            const auto interval = elapsed - last_elapsed_;
+            if (interval < min_sample_interval)
             {
-                for (size_t i = 0; i < total_count_; ++i)
-                {
-                    std::cout << "\x1b[A";
-                }
+                return;
             }
-            for (auto &bar : bars_)
+            const auto seconds = std::chrono::duration<double>(interval).count();
+            const auto current = (work - last_work_) / seconds;
+            if (has_rate_)
             {
-                bar.get().print_progress(true);
-                std::cout << "\n";
+                rate_ += (1.0 - std::exp(-seconds / time_constant)) * (current - rate_);
             }
-            if (!started_)
+            else
             {
-                started_ = true;
+                rate_ = current;
+                has_rate_ = true;
             }
+            last_work_ = work;
+            last_elapsed_ = elapsed;
+        }
+
+        std::chrono::nanoseconds RateEstimator::remaining(double remaining_work) const
+        {
+            const auto seconds = remaining_work / rate_;
+            // Capped far below what nanoseconds can hold
+            return std::chrono::nanoseconds(static_cast<long long>(std::min(seconds, 1e8) * 1e9));
         }
-        total_count_ = bars_.size();
-        std::cout << termcolor::reset;
-    }
-} // namespace indicators
\ No newline at end of file
+    } // namespace details
+} // namespace indicators
@@ -0,0 +1,94 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Row state
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/details/row_state.h"
+
+#include <thread>
+
+namespace indicators
+{
+    namespace details
+    {
+        void RowState::attach(RowListener *listener)
+        {
+            dirty_.store(true, std::memory_order_relaxed);
+            listener_.store(listener, std::memory_order_release);
+        }
+
+        void RowState::detach(RowListener *listener)
+        {
+            listener_.compare_exchange_strong(listener, nullptr);
+            // A caller that loaded the listener before it was cleared counted itself first
+            while (calls_.load() != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        void RowState::changed(bool completed)
+        {
+            mark_dirty();
+            if (!listener_.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+            // Counted before the listener is loaded again, so detach() cannot miss this call
+            calls_.fetch_add(1);
+            if (auto *listener = listener_.load())
+            {
+                listener->row_changed(completed);
+            }
+            calls_.fetch_sub(1);
+        }
+
+        void RowState::mark_dirty()
+        {
+            // Read first, so that ticks on a row that is already dirty do not bounce the cache line
+            if (!dirty_.load(std::memory_order_relaxed))
+            {
+                dirty_.store(true, std::memory_order_release);
+            }
+        }
+
+        bool RowState::take_dirty()
+        {
+            return dirty_.load(std::memory_order_relaxed) && dirty_.exchange(false, std::memory_order_acquire);
+        }
+    } // namespace details
+} // namespace indicators
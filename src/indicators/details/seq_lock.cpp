@@ -0,0 +1,123 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Sequence lock
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/details/seq_lock.h"
+
+#include <indicators/details/shared_bar_state.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <cerrno>
+#include <signal.h>
+#endif
+
+namespace indicators
+{
+    namespace details
+    {
+        namespace
+        {
+            bool process_alive(long long pid)
+            {
+#if defined(_WIN32)
+                auto process = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+                if (!process)
+                {
+                    return GetLastError() == ERROR_ACCESS_DENIED;
+                }
+                const auto alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+                CloseHandle(process);
+                return alive;
+#else
+                return kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH;
+#endif
+            }
+        } // namespace
+
+        unsigned SeqLock::write_begin()
+        {
+            auto version = version_.load(std::memory_order_relaxed);
+            unsigned spins = 0;
+            do
+            {
+                while (version & 1)
+                {
+                    // A process that died inside its write left the version odd for good. Checked
+                    // now and then only, since a live writer is done within a few hundred spins.
+                    if (++spins % 4096 == 0)
+                    {
+                        auto writer = writer_.load(std::memory_order_relaxed);
+                        if (writer != 0 && !process_alive(writer) && writer_.compare_exchange_strong(writer, current_process_id(), std::memory_order_acquire, std::memory_order_relaxed))
+                        {
+                            // Only one waiter wins the writer, and the version stays odd while it takes over
+                            // the write. Moving it on makes readers drop anything the dead writer left half done.
+                            version = version_.load(std::memory_order_relaxed);
+                            version_.store(version + 2, std::memory_order_relaxed);
+                            std::atomic_thread_fence(std::memory_order_release);
+                            return version + 1;
+                        }
+                    }
+                    version = version_.load(std::memory_order_relaxed);
+                }
+            } while (!version_.compare_exchange_weak(version, version + 1, std::memory_order_acquire, std::memory_order_relaxed));
+            writer_.store(current_process_id(), std::memory_order_relaxed);
+            // Readers that see any of the writes that follow also see the odd version
+            std::atomic_thread_fence(std::memory_order_release);
+            return version;
+        }
+
+        void SeqLock::write_end(unsigned version)
+        {
+            writer_.store(0, std::memory_order_relaxed);
+            version_.store(version + 2, std::memory_order_release);
+        }
+
+        unsigned SeqLock::read_begin() const
+        {
+            return version_.load(std::memory_order_acquire);
+        }
+
+        bool SeqLock::read_valid(unsigned version) const
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return !(version & 1) && version_.load(std::memory_order_relaxed) == version;
+        }
+    } // namespace details
+} // namespace indicators
@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Sharded counter
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/details/sharded_counter.h"
+
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace indicators
+{
+    namespace details
+    {
+        constexpr size_t ShardedCounter::cache_line_size;
+        constexpr std::int64_t ShardedCounter::batch;
+
+        ShardedCounter::ShardedCounter(size_t shards)
+        {
+            if (shards == 0)
+            {
+                shards = std::thread::hardware_concurrency();
+            }
+            size_t size = 1;
+            while (size < shards)
+            {
+                size <<= 1;
+            }
+            slots_.reset(new Slot[size]);
+            mask_ = size - 1;
+        }
+
+        void ShardedCounter::add(std::int64_t delta)
+        {
+            // Sequentially consistent on purpose: the thread whose update lands last
+            // must observe every other slot when it checks for completion
+            auto &slot = local_slot();
+            const auto value = slot.value.fetch_add(delta) + delta;
+            if (value >= batch || value <= -batch)
+            {
+                central_.fetch_add(slot.value.exchange(0));
+            }
+        }
+
+        std::int64_t ShardedCounter::sum() const
+        {
+            auto result = central_.load();
+            for (size_t i = 0; i <= mask_; ++i)
+            {
+                result += slots_[i].value.load();
+            }
+            return result;
+        }
+
+        std::int64_t ShardedCounter::approximate() const
+        {
+            return central_.load();
+        }
+
+        std::int64_t ShardedCounter::error_bound() const
+        {
+            return batch * static_cast<std::int64_t>(mask_ + 1);
+        }
+
+        size_t ShardedCounter::shards() const
+        {
+            return mask_ + 1;
+        }
+
+        ShardedCounter::Slot &ShardedCounter::local_slot()
+        {
+#if defined(__linux__)
+            // glibc answers this from rseq or the vDSO, without entering the kernel
+            const int cpu = sched_getcpu();
+            if (cpu >= 0)
+            {
+                return slots_[static_cast<size_t>(cpu) & mask_];
+            }
+#endif
+            static std::atomic<size_t> next_thread_index{0};
+            thread_local const size_t thread_index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+            return slots_[thread_index & mask_];
+        }
+    } // namespace details
+} // namespace indicators
\ No newline at end of file
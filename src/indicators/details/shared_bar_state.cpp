@@ -0,0 +1,116 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Progress bar state shared between processes
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/details/shared_bar_state.h"
+
+#include <mutex>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+namespace indicators
+{
+    namespace details
+    {
+        static_assert(ATOMIC_BOOL_LOCK_FREE == 2 && ATOMIC_CHAR_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2 &&
+                          ATOMIC_LONG_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+                      "Shared progress needs lock-free atomics");
+
+        constexpr size_t SharedBarState::postfix_capacity;
+
+        namespace
+        {
+            std::atomic<long long> process_id{0};
+
+            void refresh_process_id()
+            {
+#if defined(_WIN32)
+                process_id.store(static_cast<long long>(GetCurrentProcessId()), std::memory_order_relaxed);
+#else
+                process_id.store(static_cast<long long>(getpid()), std::memory_order_relaxed);
+#endif
+            }
+        } // namespace
+
+        long long current_process_id()
+        {
+            // getpid() is a system call on current glibc, and this is asked on every tick of a shared bar
+            static std::once_flag registered;
+            std::call_once(registered, [] {
+#if !defined(_WIN32)
+                pthread_atfork(nullptr, nullptr, refresh_process_id);
+#endif
+                refresh_process_id();
+            });
+            return process_id.load(std::memory_order_relaxed);
+        }
+
+        bool SharedBarState::is_owner() const
+        {
+            return owner.load(std::memory_order_relaxed) == current_process_id();
+        }
+
+        void SharedBarState::publish_postfix(const std::string &text)
+        {
+            const auto version = postfix_lock.write_begin();
+            postfix.store(text);
+            postfix_lock.write_end(version);
+        }
+
+        bool SharedBarState::read_postfix(unsigned &seen_version, std::string &text) const
+        {
+            const auto version = postfix_lock.read_begin();
+            if (version == seen_version || (version & 1))
+            {
+                return false;
+            }
+            postfix.load(text);
+            if (!postfix_lock.read_valid(version))
+            {
+                return false;
+            }
+            seen_version = version;
+            return true;
+        }
+    } // namespace details
+} // namespace indicators
@@ -0,0 +1,110 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Status snapshots of an indicator
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/details/status_cell.h"
+
+#include <mutex>
+#include <thread>
+
+namespace indicators
+{
+    namespace details
+    {
+        constexpr size_t StatusCell::capacity;
+
+        void StatusCell::publish(const std::string &json)
+        {
+            if (json.size() >= capacity)
+            {
+                std::lock_guard<std::mutex> lock{overflow_mutex_};
+                overflow_.assign(json);
+            }
+            const auto version = lock_.write_begin();
+            // An empty text sends the reader to the overflow buffer, a snapshot is never empty
+            text_.store(json.size() < capacity ? json : std::string());
+            lock_.write_end(version);
+        }
+
+        bool StatusCell::read(std::string &json) const
+        {
+            for (;;)
+            {
+                const auto version = lock_.read_begin();
+                if (!(version & 1))
+                {
+                    text_.load(json);
+                    if (lock_.read_valid(version))
+                    {
+                        if (version != 0 && json.empty())
+                        {
+                            std::lock_guard<std::mutex> lock{overflow_mutex_};
+                            json.assign(overflow_);
+                        }
+                        return version != 0;
+                    }
+                }
+                std::this_thread::yield();
+            }
+        }
+
+        StatusCell &StatusSlot::cell()
+        {
+            if (!cell_)
+            {
+                cell_.reset(new StatusCell());
+            }
+            return *cell_;
+        }
+
+        bool StatusSlot::enabled() const
+        {
+            return cell_ != nullptr;
+        }
+
+        std::string &StatusSlot::buffer()
+        {
+            return buffer_;
+        }
+
+        void StatusSlot::publish()
+        {
+            cell_->publish(buffer_);
+        }
+    } // namespace details
+} // namespace indicators
@@ -132,5 +132,155 @@ namespace indicators
             os.fill(fill);
             return os;
         }
+
+        void append_number(std::string &out, size_t value, size_t min_digits)
+        {
+            char digits[24];
+            size_t length = 0;
+            do
+            {
+                digits[length++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value > 0);
+
+            for (; min_digits > length; --min_digits)
+            {
+                out.push_back('0');
+            }
+            while (length > 0)
+            {
+                out.push_back(digits[--length]);
+            }
+        }
+
+        void append_duration(std::string &out, std::chrono::nanoseconds ns)
+        {
+            using namespace std::chrono;
+            using days = duration<int, std::ratio<86400>>;
+            auto d = duration_cast<days>(ns);
+            ns -= d;
+            auto h = duration_cast<hours>(ns);
+            ns -= h;
+            auto m = duration_cast<minutes>(ns);
+            ns -= m;
+            auto s = duration_cast<seconds>(ns);
+            if (d.count() > 0)
+            {
+                append_number(out, static_cast<size_t>(d.count()), 2);
+                out.append("d:");
+            }
+            if (h.count() > 0)
+            {
+                append_number(out, static_cast<size_t>(h.count()), 2);
+                out.append("h:");
+            }
+            append_number(out, static_cast<size_t>(m.count()), 2);
+            out.append("m:");
+            append_number(out, static_cast<size_t>(s.count()), 2);
+            out.push_back('s');
+        }
+
+        void append_grouped_number(std::string &out, size_t value)
+        {
+            char digits[32];
+            size_t length = 0;
+            do
+            {
+                if (length % 4 == 3)
+                {
+                    digits[length++] = ',';
+                }
+                digits[length++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value > 0);
+
+            while (length > 0)
+            {
+                out.push_back(digits[--length]);
+            }
+        }
+
+        ScaledRate scale_rate(double per_second)
+        {
+            size_t prefix = 0;
+            while (per_second >= 999.95 && prefix < 5)
+            {
+                per_second /= 1000;
+                ++prefix;
+            }
+            return ScaledRate{std::llround(std::max(per_second, 0.0) * 10), prefix};
+        }
+
+        void append_rate(std::string &out, ScaledRate rate, const std::string &unit)
+        {
+            static const char *const prefixes[] = {"", "k", "M", "G", "T", "P"};
+            append_number(out, static_cast<size_t>(rate.tenths / 10));
+            out.push_back('.');
+            append_number(out, static_cast<size_t>(rate.tenths % 10));
+            out.push_back(' ');
+            out.append(prefixes[rate.prefix]);
+            out.append(unit);
+            out.append("/s");
+        }
+
+        void DurationText::append(std::string &out, std::chrono::nanoseconds ns)
+        {
+            const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(ns).count();
+            if (seconds != seconds_ || text_.empty())
+            {
+                text_.clear();
+                append_duration(text_, ns);
+                seconds_ = seconds;
+            }
+            out.append(text_);
+        }
+
+        void StylePrefix::set(Color color, const std::vector<FontStyle> &styles)
+        {
+            // Same codes as the termcolor manipulators
+            static const char *const color_codes[] = {"30", "31", "32", "33", "34", "35", "36", "37"};
+            static const char *const style_codes[] = {"1", "2", "3", "4", "5", "7", "8", "9"};
+
+            color_ = color;
+            styles_ = styles;
+            codes_.clear();
+            sequence_.clear();
+            if (color != Color::unspecified)
+            {
+                codes_.append(color_codes[static_cast<size_t>(color)]);
+            }
+            for (auto style : styles)
+            {
+                if (!codes_.empty())
+                {
+                    codes_.push_back(';');
+                }
+                codes_.append(style_codes[static_cast<size_t>(style)]);
+            }
+            if (!codes_.empty())
+            {
+                sequence_.append("\033[").append(codes_).push_back('m');
+            }
+        }
+
+        void StylePrefix::append(std::string &out, std::ostream &os) const
+        {
+            if (sequence_.empty() || !termcolor::_internal::is_colorized(os))
+            {
+                return;
+            }
+#if defined(TERMCOLOR_OS_WINDOWS)
+            if (color_ != Color::unspecified)
+            {
+                set_stream_color(os, color_);
+            }
+            for (auto style : styles_)
+            {
+                set_font_style(os, style);
+            }
+#else
+            out.append(sequence_);
+#endif
+        }
     } // namespace details
 } // namespace indicators
\ No newline at end of file
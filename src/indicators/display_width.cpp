@@ -40,17 +40,23 @@
 #include "indicators/display_width.h"
 
 #include <cstdlib>
-#include <locale>
 #include <string>
 #include <wchar.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define INDICATORS_DISPLAY_WIDTH_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define INDICATORS_DISPLAY_WIDTH_SSE2 1
+#endif
+
 namespace unicode
 {
-
-#if INDICATORS_HAVE_CODECVT
     namespace details
     {
-        int bisearch(wchar_t ucs, const struct interval *table, int max)
+        int bisearch(char32_t ucs, const struct interval *table, int max)
         {
             int min = 0;
             int mid;
@@ -80,7 +86,7 @@ namespace unicode
             return 0;
         }
 
-        int mk_wcwidth(wchar_t ucs)
+        int mk_wcwidth(char32_t ucs)
         {
             /* sorted list of non-overlapping intervals of non-spacing characters */
             /* generated by "uniset +cat=Me +cat=Mn +cat=Cf -00AD +1160-11FF +200B c" */
@@ -173,7 +179,7 @@ namespace unicode
             return width;
         }
 
-        int mk_wcwidth_cjk(wchar_t ucs)
+        int mk_wcwidth_cjk(char32_t ucs)
         {
             /*
                 sorted list of non-overlapping intervals of East Asian Ambiguous
@@ -248,37 +254,215 @@ namespace unicode
             return width;
         }
 
+        size_t utf8_next(const unsigned char *input, const unsigned char *end, char32_t &ucs)
+        {
+            constexpr char32_t replacement = 0xFFFD;
+            const unsigned char lead = input[0];
+            size_t length;
+            char32_t min;
+
+            if (lead < 0x80)
+            {
+                ucs = lead;
+                return 1;
+            }
+            else if ((lead & 0xE0) == 0xC0)
+            {
+                length = 2;
+                min = 0x80;
+                ucs = lead & 0x1F;
+            }
+            else if ((lead & 0xF0) == 0xE0)
+            {
+                length = 3;
+                min = 0x800;
+                ucs = lead & 0x0F;
+            }
+            else if ((lead & 0xF8) == 0xF0)
+            {
+                length = 4;
+                min = 0x10000;
+                ucs = lead & 0x07;
+            }
+            else
+            {
+                ucs = replacement;
+                return 1;
+            }
+
+            if (static_cast<size_t>(end - input) < length)
+            {
+                ucs = replacement;
+                return 1;
+            }
+            for (size_t i = 1; i < length; ++i)
+            {
+                if ((input[i] & 0xC0) != 0x80)
+                {
+                    ucs = replacement;
+                    return 1;
+                }
+                ucs = (ucs << 6) | (input[i] & 0x3F);
+            }
+            if (ucs < min || ucs > 0x10FFFF || (ucs >= 0xD800 && ucs <= 0xDFFF))
+            {
+                ucs = replacement;
+                return 1;
+            }
+            return length;
+        }
+
+        size_t printable_ascii_prefix(const unsigned char *input, const unsigned char *end)
+        {
+            const auto *p = input;
+            /*
+                A block is consumed whole only if every byte is in 0x20-0x7E. The compares are
+                signed, so bytes from 0x80 up are negative and fail the lower bound. The scalar
+                loop then finds the first byte that stopped the block.
+            */
+#if INDICATORS_DISPLAY_WIDTH_AVX2
+            const __m256i below_32 = _mm256_set1_epi8(0x1F);
+            const __m256i del_32 = _mm256_set1_epi8(0x7F);
+            while (end - p >= 32)
+            {
+                const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+                const __m256i printable = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, below_32), _mm256_cmpgt_epi8(del_32, bytes));
+                if (static_cast<unsigned>(_mm256_movemask_epi8(printable)) != 0xFFFFFFFFu)
+                {
+                    break;
+                }
+                p += 32;
+            }
+#endif
+#if INDICATORS_DISPLAY_WIDTH_SSE2
+            const __m128i below_16 = _mm_set1_epi8(0x1F);
+            const __m128i del_16 = _mm_set1_epi8(0x7F);
+            while (end - p >= 16)
+            {
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(bytes, below_16), _mm_cmplt_epi8(bytes, del_16));
+                if (_mm_movemask_epi8(printable) != 0xFFFF)
+                {
+                    break;
+                }
+                p += 16;
+            }
+#endif
+            while (p < end && *p >= 0x20 && *p < 0x7F)
+            {
+                ++p;
+            }
+            return static_cast<size_t>(p - input);
+        }
+
         std::wstring utf8_decode(const std::string &str)
         {
-            std::wstring_convert<std::codecvt_utf8<wchar_t>> myconv;
-            return myconv.from_bytes(str);
+            std::wstring result;
+            result.reserve(str.size());
+            const auto *p = reinterpret_cast<const unsigned char *>(str.data());
+            const auto *end = p + str.size();
+            while (p < end)
+            {
+                char32_t ucs;
+                p += utf8_next(p, end, ucs);
+                if (sizeof(wchar_t) == 2 && ucs > 0xFFFF)
+                {
+                    // UTF-16 surrogate pair
+                    ucs -= 0x10000;
+                    result.push_back(static_cast<wchar_t>(0xD800 + (ucs >> 10)));
+                    result.push_back(static_cast<wchar_t>(0xDC00 + (ucs & 0x3FF)));
+                }
+                else
+                {
+                    result.push_back(static_cast<wchar_t>(ucs));
+                }
+            }
+            return result;
         }
 
         std::string utf8_encode(const std::wstring &str)
         {
-            std::wstring_convert<std::codecvt_utf8<wchar_t>> myconv;
-            return myconv.to_bytes(str);
+            std::string result;
+            result.reserve(str.size());
+            for (size_t i = 0; i < str.size(); ++i)
+            {
+                char32_t ucs = static_cast<char32_t>(str[i]);
+                if (sizeof(wchar_t) == 2 && ucs >= 0xD800 && ucs <= 0xDBFF && i + 1 < str.size())
+                {
+                    const char32_t low = static_cast<char32_t>(str[i + 1]);
+                    if (low >= 0xDC00 && low <= 0xDFFF)
+                    {
+                        ucs = 0x10000 + ((ucs - 0xD800) << 10) + (low - 0xDC00);
+                        ++i;
+                    }
+                }
+
+                if (ucs < 0x80)
+                {
+                    result.push_back(static_cast<char>(ucs));
+                }
+                else if (ucs < 0x800)
+                {
+                    result.push_back(static_cast<char>(0xC0 | (ucs >> 6)));
+                    result.push_back(static_cast<char>(0x80 | (ucs & 0x3F)));
+                }
+                else if (ucs < 0x10000)
+                {
+                    result.push_back(static_cast<char>(0xE0 | (ucs >> 12)));
+                    result.push_back(static_cast<char>(0x80 | ((ucs >> 6) & 0x3F)));
+                    result.push_back(static_cast<char>(0x80 | (ucs & 0x3F)));
+                }
+                else
+                {
+                    result.push_back(static_cast<char>(0xF0 | (ucs >> 18)));
+                    result.push_back(static_cast<char>(0x80 | ((ucs >> 12) & 0x3F)));
+                    result.push_back(static_cast<char>(0x80 | ((ucs >> 6) & 0x3F)));
+                    result.push_back(static_cast<char>(0x80 | (ucs & 0x3F)));
+                }
+            }
+            return result;
         }
     } // namespace details
-#endif
 
-    int display_width(const std::string &input)
+    int display_width(const char *input, size_t length)
     {
-#if INDICATORS_HAVE_CODECVT
         using namespace unicode::details;
-        return mk_wcswidth(utf8_decode(input).c_str(), input.size());
-#else
-        return input.length();
-#endif
+        const auto *p = reinterpret_cast<const unsigned char *>(input);
+        const auto *end = p + length;
+        int width = 0;
+        while (p < end)
+        {
+            const auto run = printable_ascii_prefix(p, end);
+            width += static_cast<int>(run);
+            p += run;
+            if (p == end)
+            {
+                break;
+            }
+
+            char32_t ucs;
+            p += utf8_next(p, end, ucs);
+            if (ucs == 0)
+            {
+                break;
+            }
+            const int w = mk_wcwidth(ucs);
+            if (w < 0)
+            {
+                return -1;
+            }
+            width += w;
+        }
+        return width;
+    }
+
+    int display_width(const std::string &input)
+    {
+        return display_width(input.data(), input.size());
     }
 
     int display_width(const std::wstring &input)
     {
-#if INDICATORS_HAVE_CODECVT
         return details::mk_wcswidth(input.c_str(), input.size());
-#else
-        return input.length();
-#endif
     }
-
 } // namespace unicode
\ No newline at end of file
@@ -49,6 +49,8 @@ namespace indicators
         {
             get_value<details::ProgressBarOption::max_postfix_text_len>() = setting.value.length();
         }
+        layout_dirty_ = true;
+        row_.mark_dirty();
     }
 
     void IndeterminateProgressBar::set_option(details::Setting<std::string, details::ProgressBarOption::postfix_text> &&setting)
@@ -60,16 +62,24 @@ namespace indicators
         {
             get_value<details::ProgressBarOption::max_postfix_text_len>() = new_value.length();
         }
+        layout_dirty_ = true;
+        row_.mark_dirty();
     }
 
     void IndeterminateProgressBar::tick()
     {
+        std::chrono::nanoseconds min_redraw_interval;
         {
             std::lock_guard<std::mutex> lock{mutex_};
             if (get_value<details::ProgressBarOption::completed>())
             {
                 return;
             }
+            if (!started_)
+            {
+                start_time_ = now();
+                started_ = true;
+            }
 
             progress_ += (direction_ == Direction::forward) ? 1 : -1;
             if (direction_ == Direction::forward && progress_ == max_progress_)
@@ -81,8 +91,25 @@ namespace indicators
             {
                 direction_ = Direction::forward;
             }
+            min_redraw_interval = get_value<details::ProgressBarOption::min_redraw_interval>();
+            if (output_format_ == OutputFormat::json_lines)
+            {
+                min_redraw_interval = details::json_line_interval(min_redraw_interval);
+            }
+            else if (output_format_ == OutputFormat::plain_lines)
+            {
+                min_redraw_interval = details::plain_line_interval(min_redraw_interval);
+            }
+        }
+        if (multi_progress_mode_)
+        {
+            // The container draws this bar as one of its rows
+            row_.changed(false);
+        }
+        else if (redraw_throttle_.try_claim(min_redraw_interval, now()))
+        {
+            print_progress();
         }
-        print_progress();
     }
 
     bool IndeterminateProgressBar::is_completed()
@@ -92,85 +119,206 @@ namespace indicators
 
     void IndeterminateProgressBar::mark_as_completed()
     {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            elapsed_ = started_ ? now() - start_time_ : std::chrono::nanoseconds::zero();
+        }
         get_value<details::ProgressBarOption::completed>() = true;
         print_progress();
+        row_.changed(true);
+    }
+
+    void IndeterminateProgressBar::on_option_changed()
+    {
+        output_format_ = details::resolve_output_format(get_value<details::ProgressBarOption::output_format>(), get_value<details::ProgressBarOption::stream>());
+        clock_.store(get_value<details::ProgressBarOption::clock>() ? get_value<details::ProgressBarOption::clock>() : &Clock::steady(), std::memory_order_release);
+        layout_dirty_ = true;
+        row_.mark_dirty();
     }
 
-    std::pair<std::string, size_t> IndeterminateProgressBar::get_prefix_text()
+    void IndeterminateProgressBar::update_layout()
     {
-        std::stringstream os;
-        os << get_value<details::ProgressBarOption::prefix_text>();
-        const auto result = os.str();
-        const auto result_size = unicode::display_width(result);
-        return {result, result_size};
+        style_.set(get_value<details::ProgressBarOption::foreground_color>(), get_value<details::ProgressBarOption::font_styles>());
+        prefix_width_ = unicode::display_width(get_value<details::ProgressBarOption::prefix_text>());
+        postfix_text_width_ = unicode::display_width(get_value<details::ProgressBarOption::postfix_text>());
+        scale_writer_.set_style(get_value<details::ProgressBarOption::bar_width>(),
+                                get_value<details::ProgressBarOption::fill>(),
+                                get_value<details::ProgressBarOption::lead>());
+        layout_dirty_ = false;
     }
 
-    std::pair<std::string, size_t> IndeterminateProgressBar::get_postfix_text()
+    size_t IndeterminateProgressBar::append_prefix_text(std::string &out)
     {
-        std::stringstream os;
-        os << " " << get_value<details::ProgressBarOption::postfix_text>();
+        out.append(get_value<details::ProgressBarOption::prefix_text>());
+        return prefix_width_;
+    }
 
-        const auto result = os.str();
-        const auto result_size = unicode::display_width(result);
-        return {result, result_size};
+    size_t IndeterminateProgressBar::append_postfix_text(std::string &out)
+    {
+        out.push_back(' ');
+        out.append(get_value<details::ProgressBarOption::postfix_text>());
+        return 1 + postfix_text_width_;
     }
 
     void IndeterminateProgressBar::print_progress(bool from_multi_progress)
     {
         std::lock_guard<std::mutex> lock{mutex_};
+        draw_progress(get_value<details::ProgressBarOption::stream>(), from_multi_progress);
+    }
 
-        auto &os = get_value<details::ProgressBarOption::stream>();
-
-        if (multi_progress_mode_ && !from_multi_progress)
+    void IndeterminateProgressBar::print_row(details::FrameStream &frame)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (layout_dirty_)
         {
-            return;
+            update_layout();
         }
-        if (get_value<details::ProgressBarOption::foreground_color>() != Color::unspecified)
+        // The frame tracks the style across rows and writes only what changes
+        frame.set_style(style_);
+        draw_progress(frame, true, frame.terminal_width());
+    }
+
+    void IndeterminateProgressBar::collect_metrics(details::BarMetrics &metrics)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        const auto completed = get_value<details::ProgressBarOption::completed>();
+        metrics.label = details::metric_label(get_value<details::ProgressBarOption::label>(), get_value<details::ProgressBarOption::prefix_text>());
+        metrics.elapsed = completed || !started_ ? elapsed_ : now() - start_time_;
+        metrics.completed = completed;
+        // The lead bounces back and forth, which says nothing about how far the work is
+        metrics.has_progress = false;
+        metrics.has_rate = false;
+    }
+
+    void IndeterminateProgressBar::append_json(std::string &out)
+    {
+        details::JsonLine json(out);
+        json.field("name", get_value<details::ProgressBarOption::prefix_text>())
+            .field("completed", get_value<details::ProgressBarOption::completed>());
+        if (!get_value<details::ProgressBarOption::postfix_text>().empty())
         {
-            details::set_stream_color(os, get_value<details::ProgressBarOption::foreground_color>());
+            json.field("postfix", get_value<details::ProgressBarOption::postfix_text>());
         }
+        json.end();
+    }
 
-        for (auto &style : get_value<details::ProgressBarOption::font_styles>())
+    void IndeterminateProgressBar::publish_status()
+    {
+        if (status_.enabled())
         {
-            details::set_font_style(os, style);
+            auto &line = status_.buffer();
+            line.clear();
+            append_json(line);
+            status_.publish();
         }
+    }
 
-        const auto prefix_pair = get_prefix_text();
-        const auto prefix_text = prefix_pair.first;
-        const auto prefix_length = prefix_pair.second;
-        os << prefix_text;
+    void IndeterminateProgressBar::print_json(std::ostream &os)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        publish_status();
+        line_.clear();
+        append_json(line_);
+        os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+    }
 
-        os << get_value<details::ProgressBarOption::start>();
+    size_t IndeterminateProgressBar::compose_row()
+    {
+        const auto prefix_length = append_prefix_text(line_);
 
-        details::IndeterminateProgressScaleWriter writer{
-            os, get_value<details::ProgressBarOption::bar_width>(),
-            get_value<details::ProgressBarOption::fill>(),
-            get_value<details::ProgressBarOption::lead>()};
+        line_.append(get_value<details::ProgressBarOption::start>());
 
-        writer.write(progress_);
+        scale_writer_.write(line_, progress_);
 
-        os << get_value<details::ProgressBarOption::end>();
+        line_.append(get_value<details::ProgressBarOption::end>());
 
-        const auto postfix_pair = get_postfix_text();
-        const auto postfix_text = postfix_pair.first;
-        const auto postfix_length = postfix_pair.second;
-        os << postfix_text;
+        const auto postfix_length = append_postfix_text(line_);
 
         // Get length of prefix text and postfix text
         const auto start_length = get_value<details::ProgressBarOption::start>().size();
         const auto bar_width = get_value<details::ProgressBarOption::bar_width>();
         const auto end_length = get_value<details::ProgressBarOption::end>().size();
-        const auto terminal_width = terminal_size().second;
+        return prefix_length + start_length + bar_width + end_length + postfix_length;
+    }
+
+    void IndeterminateProgressBar::write_plain_line(std::ostream &os, bool final)
+    {
+        if (!plain_schedule_.due(0, final, now()))
+        {
+            return;
+        }
+        if (layout_dirty_)
+        {
+            update_layout();
+        }
+        line_.clear();
+        compose_row();
+        details::end_plain_line(line_);
+        os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+        os.flush();
+    }
+
+    void IndeterminateProgressBar::print_plain(std::ostream &os)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        publish_status();
+        write_plain_line(os, get_value<details::ProgressBarOption::completed>());
+    }
+
+    bool IndeterminateProgressBar::take_row_dirty()
+    {
+        return row_.take_dirty();
+    }
+
+    void IndeterminateProgressBar::draw_progress(std::ostream &os, bool from_multi_progress)
+    {
+        draw_progress(os, from_multi_progress, terminal_size(os).second);
+    }
+
+    void IndeterminateProgressBar::draw_progress(std::ostream &os, bool from_multi_progress, size_t terminal_width)
+    {
+        if (multi_progress_mode_ && !from_multi_progress)
+        {
+            return;
+        }
+        publish_status();
+        if (output_format_ == OutputFormat::json_lines && !from_multi_progress)
+        {
+            line_.clear();
+            append_json(line_);
+            os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+            os.flush();
+            return;
+        }
+        if (output_format_ == OutputFormat::plain_lines && !from_multi_progress)
+        {
+            write_plain_line(os, get_value<details::ProgressBarOption::completed>());
+            return;
+        }
+
+        if (layout_dirty_)
+        {
+            update_layout();
+        }
+
+        line_.clear();
+        if (!from_multi_progress)
+        {
+            style_.append(line_, os);
+        }
+
         // prefix + bar_width + postfix should be <= terminal_width
-        const int remaining = terminal_width - (prefix_length + start_length + bar_width + end_length + postfix_length);
+        const int remaining = terminal_width - compose_row();
         if (remaining > 0)
         {
-            os << std::string(remaining, ' ') << "\r";
+            line_.append(remaining, ' ');
+            line_.push_back('\r');
         }
         else if (remaining < 0)
         {
             // Do nothing. Maybe in the future truncate postfix with ...
         }
+        os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
         os.flush();
 
         if (get_value<details::ProgressBarOption::completed>() && !from_multi_progress) // Don't std::endl if calling from MultiProgress
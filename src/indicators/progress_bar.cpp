@@ -41,6 +41,8 @@
 
 namespace indicators
 {
+    constexpr size_t ProgressBar::aggregate_resolution;
+
     void ProgressBar::set_option(const details::Setting<std::string, details::ProgressBarOption::postfix_text> &setting)
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -49,6 +51,14 @@ namespace indicators
         {
             get_value<details::ProgressBarOption::max_postfix_text_len>() = setting.value.length();
         }
+        on_option_changed();
+        if (auto *shared = shared_.load(std::memory_order_relaxed))
+        {
+            if (!shared->is_owner())
+            {
+                shared->publish_postfix(setting.value);
+            }
+        }
     }
 
     void ProgressBar::set_option(details::Setting<std::string, details::ProgressBarOption::postfix_text> &&setting)
@@ -60,92 +70,552 @@ namespace indicators
         {
             get_value<details::ProgressBarOption::max_postfix_text_len>() = new_value.length();
         }
+        on_option_changed();
+        if (auto *shared = shared_.load(std::memory_order_relaxed))
+        {
+            if (!shared->is_owner())
+            {
+                shared->publish_postfix(new_value);
+            }
+        }
+    }
+
+    void ProgressBar::set_option(const details::Setting<bool, details::ProgressBarOption::completed> &setting)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        get_value<details::ProgressBarOption::completed>() = setting.value;
+        state_.store(setting.value ? State::completed : State::running, std::memory_order_release);
+        row_.mark_dirty();
+    }
+
+    void ProgressBar::set_option(details::Setting<bool, details::ProgressBarOption::completed> &&setting)
+    {
+        set_option(static_cast<const details::Setting<bool, details::ProgressBarOption::completed> &>(setting));
     }
 
     void ProgressBar::set_progress(size_t new_progress)
     {
+        const auto *shards = shards_.load(std::memory_order_acquire);
+        counter().store(shards ? new_progress - static_cast<size_t>(shards->sum()) : new_progress, std::memory_order_relaxed);
+        update_parent(new_progress);
+        on_progress_changed(reached_end(new_progress));
+    }
+
+    void ProgressBar::tick()
+    {
+        tick(1);
+    }
+
+    void ProgressBar::tick(size_t n)
+    {
+        const auto decremental = decremental_.load(std::memory_order_relaxed);
+        if (auto *shards = shards_.load(std::memory_order_acquire))
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            progress_ = new_progress;
+            const auto delta = static_cast<std::int64_t>(n);
+            shards->add(decremental ? -delta : delta);
+            if (parent_.load(std::memory_order_acquire))
+            {
+                // The estimate is close enough for the aggregate, and exact once the bar completes
+                update_parent(counter().load(std::memory_order_relaxed) + static_cast<size_t>(shards->approximate()));
+            }
+            on_progress_changed(state_.load(std::memory_order_relaxed) == State::running && sharded_reached_end(*shards));
+            return;
         }
 
-        save_start_time();
-        print_progress();
+        size_t progress;
+        if (decremental)
+        {
+            progress = counter().fetch_sub(n, std::memory_order_relaxed) - n;
+        }
+        else
+        {
+            progress = counter().fetch_add(n, std::memory_order_relaxed) + n;
+        }
+        update_parent(progress);
+        on_progress_changed(reached_end(progress));
     }
 
-    void ProgressBar::tick()
+    size_t ProgressBar::current()
+    {
+        return std::min(load_progress(), max_progress_.load(std::memory_order_relaxed));
+    }
+
+    size_t ProgressBar::load_progress() const
+    {
+        auto progress = counter().load(std::memory_order_relaxed);
+        if (const auto *shards = shards_.load(std::memory_order_acquire))
+        {
+            progress += static_cast<size_t>(shards->sum());
+        }
+        return progress;
+    }
+
+    bool ProgressBar::sharded_reached_end(const details::ShardedCounter &shards) const
+    {
+        // Only visit every slot once the cheap estimate is within its error bound of the end
+        const auto base = counter().load(std::memory_order_relaxed);
+        const auto tolerance = static_cast<size_t>(shards.error_bound());
+        const auto approximate = base + static_cast<size_t>(shards.approximate());
+        if (decremental_.load(std::memory_order_relaxed))
+        {
+            if (approximate > min_progress_.load(std::memory_order_relaxed) + tolerance)
+            {
+                return false;
+            }
+        }
+        else if (approximate + tolerance < max_progress_.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+        return reached_end(base + static_cast<size_t>(shards.sum()));
+    }
+
+    void ProgressBar::add_child(ProgressBar &child, size_t weight)
     {
         {
             std::lock_guard<std::mutex> lock{mutex_};
-            const auto type = get_value<details::ProgressBarOption::progress_type>();
-            if (type == ProgressType::incremental)
+            if (child_count_++ == 0)
             {
-                progress_ += 1;
+                // The work of an aggregate is the work of its children
+                get_value<details::ProgressBarOption::min_progress>() = 0;
+                get_value<details::ProgressBarOption::max_progress>() = 0;
+                get_value<details::ProgressBarOption::progress_type>() = ProgressType::incremental;
+                counter().store(0, std::memory_order_relaxed);
             }
-            else
+            get_value<details::ProgressBarOption::max_progress>() += weight * aggregate_resolution;
+            on_option_changed();
+        }
+        reopen();
+
+        child.parent_weight_.store(weight, std::memory_order_relaxed);
+        child.parent_work_.store(0, std::memory_order_relaxed);
+        child.parent_.store(this, std::memory_order_release);
+        child.update_parent(child.load_progress());
+    }
+
+    void ProgressBar::reopen()
+    {
+        // An aggregate that completed before it got more work runs again, and so do the aggregates above it
+        for (auto *bar = this; bar; bar = bar->parent_.load(std::memory_order_acquire))
+        {
             {
-                progress_ -= 1;
+                std::lock_guard<std::mutex> lock{bar->mutex_};
+                if (bar->state_.load(std::memory_order_acquire) == State::running ||
+                    bar->reached_end(bar->counter().load(std::memory_order_relaxed)))
+                {
+                    return;
+                }
+                bar->state_.store(State::running, std::memory_order_release);
+                bar->row_.mark_dirty();
             }
+            bar->update_parent(bar->load_progress());
         }
-        save_start_time();
-        print_progress();
     }
 
-    size_t ProgressBar::current()
+    size_t ProgressBar::weighted_work(size_t progress) const
     {
-        std::lock_guard<std::mutex> lock{mutex_};
-        return std::min(progress_, size_t(get_value<details::ProgressBarOption::max_progress>()));
+        const auto full = parent_weight_.load(std::memory_order_relaxed) * aggregate_resolution;
+        const auto min_progress = min_progress_.load(std::memory_order_relaxed);
+        const auto max_progress = max_progress_.load(std::memory_order_relaxed);
+        if (state_.load(std::memory_order_acquire) != State::running || max_progress <= min_progress)
+        {
+            return full;
+        }
+        progress = std::min(std::max(progress, min_progress), max_progress);
+        const auto done = decremental_.load(std::memory_order_relaxed) ? max_progress - progress : progress - min_progress;
+        return static_cast<size_t>(double(full) * double(done) / double(max_progress - min_progress));
+    }
+
+    void ProgressBar::update_parent(size_t progress)
+    {
+        auto *parent = parent_.load(std::memory_order_acquire);
+        if (!parent)
+        {
+            return;
+        }
+        // Only the difference to what was reported before travels up, so concurrent updates never double count
+        const auto work = weighted_work(progress);
+        const auto reported = parent_work_.exchange(work, std::memory_order_relaxed);
+        if (work != reported)
+        {
+            parent->add_work(work - reported);
+        }
+    }
+
+    void ProgressBar::add_work(size_t delta)
+    {
+        // Wraps around for negative deltas, which unsigned addition undoes
+        const auto progress = counter().fetch_add(delta, std::memory_order_relaxed) + delta;
+        update_parent(progress);
+        on_progress_changed(reached_end(progress));
     }
 
     void ProgressBar::mark_as_completed()
     {
-        get_value<details::ProgressBarOption::completed>() = true;
+        if (auto *shared = shared_.load(std::memory_order_acquire))
+        {
+            if (!shared->is_owner())
+            {
+                shared->completed.store(true, std::memory_order_release);
+                return;
+            }
+        }
+        if (renderer_mode_.load())
+        {
+            // Leave the last frame to the renderer, unless it detached in the meantime
+            state_.store(State::finishing);
+            if (renderer_mode_.load())
+            {
+                update_parent(load_progress());
+                return;
+            }
+        }
+        state_.store(State::completed, std::memory_order_release);
+        update_parent(load_progress());
         print_progress();
+        row_.changed(true);
+    }
+
+    void ProgressBar::on_option_changed()
+    {
+        if (auto *shared = get_value<details::ProgressBarOption::shared_state>())
+        {
+            bind_shared_state(shared);
+        }
+        decremental_.store(get_value<details::ProgressBarOption::progress_type>() == ProgressType::decremental, std::memory_order_relaxed);
+        min_progress_.store(get_value<details::ProgressBarOption::min_progress>(), std::memory_order_relaxed);
+        max_progress_.store(get_value<details::ProgressBarOption::max_progress>(), std::memory_order_relaxed);
+        output_format_ = details::resolve_output_format(get_value<details::ProgressBarOption::output_format>(), get_value<details::ProgressBarOption::stream>());
+        auto min_redraw_interval = get_value<details::ProgressBarOption::min_redraw_interval>();
+        if (output_format_ == OutputFormat::json_lines)
+        {
+            min_redraw_interval = details::json_line_interval(min_redraw_interval);
+        }
+        else if (output_format_ == OutputFormat::plain_lines)
+        {
+            min_redraw_interval = details::plain_line_interval(min_redraw_interval);
+        }
+        min_redraw_interval_ns_.store(min_redraw_interval.count(), std::memory_order_relaxed);
+        clock_.store(get_value<details::ProgressBarOption::clock>() ? get_value<details::ProgressBarOption::clock>() : &Clock::steady(), std::memory_order_release);
+        shows_time_.store(get_value<details::ProgressBarOption::show_elapsed_time>() ||
+                              get_value<details::ProgressBarOption::show_remaining_time>() ||
+                              get_value<details::ProgressBarOption::show_rate>(),
+                          std::memory_order_relaxed);
+        // Recorded whether or not it is shown, for the rate and ETA of JSON lines
+        start_time_pending_.store(!get_value<details::ProgressBarOption::saved_start_time>(), std::memory_order_relaxed);
+        if (auto *shared = shared_.load(std::memory_order_relaxed))
+        {
+            shared->max_progress.store(get_value<details::ProgressBarOption::max_progress>(), std::memory_order_release);
+        }
+        // Shards live in the memory of one process, so a shared bar keeps counting in its slot
+        if (get_value<details::ProgressBarOption::sharded_progress>() && !shard_storage_ && !shared_.load(std::memory_order_relaxed))
+        {
+            shard_storage_.reset(new details::ShardedCounter());
+            shards_.store(shard_storage_.get(), std::memory_order_release);
+        }
+        layout_dirty_ = true;
+        ++layout_version_;
+        row_.mark_dirty();
+    }
+
+    void ProgressBar::bind_shared_state(details::SharedBarState *shared)
+    {
+        if (shared_.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        if (shared->is_owner())
+        {
+            shared->progress.store(local_progress_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        else
+        {
+            // A worker takes over the range its owner set up
+            get_value<details::ProgressBarOption::max_progress>() = shared->max_progress.load(std::memory_order_acquire);
+        }
+        shared_progress_ = shared->progress.load(std::memory_order_relaxed);
+        counter_.store(&shared->progress, std::memory_order_release);
+        shared_.store(shared, std::memory_order_release);
+    }
+
+    bool ProgressBar::sync_shared_state()
+    {
+        auto *shared = shared_.load(std::memory_order_acquire);
+        if (!shared || !shared->is_owner())
+        {
+            return false;
+        }
+
+        auto changed = false;
+        const auto max_progress = shared->max_progress.load(std::memory_order_acquire);
+        if (max_progress != get_value<details::ProgressBarOption::max_progress>())
+        {
+            get_value<details::ProgressBarOption::max_progress>() = max_progress;
+            changed = true;
+        }
+        if (shared->read_postfix(shared_postfix_version_, shared_postfix_))
+        {
+            get_value<details::ProgressBarOption::postfix_text>() = shared_postfix_;
+            auto &max_postfix_text_len = get_value<details::ProgressBarOption::max_postfix_text_len>();
+            max_postfix_text_len = std::max(max_postfix_text_len, shared_postfix_.length());
+            changed = true;
+        }
+        if (changed)
+        {
+            on_option_changed();
+        }
+
+        const auto progress = counter().load(std::memory_order_relaxed);
+        if (progress != shared_progress_)
+        {
+            shared_progress_ = progress;
+            if (start_time_pending_.load(std::memory_order_relaxed))
+            {
+                save_start_time();
+            }
+            changed = true;
+        }
+        if (shared->completed.load(std::memory_order_acquire) || reached_end(progress))
+        {
+            // The last frame is drawn here, as it would be by the update that finished a local bar
+            auto expected = State::running;
+            changed |= state_.compare_exchange_strong(expected, multi_progress_mode_ ? State::completed : State::finishing);
+        }
+        return changed;
+    }
+
+    void ProgressBar::on_progress_changed(bool at_end)
+    {
+        if (auto *shared = shared_.load(std::memory_order_relaxed))
+        {
+            if (!shared->is_owner())
+            {
+                // Workers only count, the owner of the slot draws
+                if (at_end)
+                {
+                    shared->completed.store(true, std::memory_order_release);
+                }
+                return;
+            }
+        }
+
+        if (start_time_pending_.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            save_start_time();
+        }
+
+        if (multi_progress_mode_.load(std::memory_order_relaxed))
+        {
+            // The container draws this bar as one of its rows, last frame included
+            if (at_end)
+            {
+                auto expected = State::running;
+                state_.compare_exchange_strong(expected, State::completed);
+            }
+            row_.changed(at_end);
+            return;
+        }
+
+        if (at_end)
+        {
+            auto expected = State::running;
+            if (state_.compare_exchange_strong(expected, State::finishing))
+            {
+                if (renderer_mode_.load())
+                {
+                    return;
+                }
+                // The update that finishes the bar always draws its last frame, unless a detaching renderer already did
+                std::lock_guard<std::mutex> lock{mutex_};
+                if (state_.load(std::memory_order_acquire) == State::finishing)
+                {
+                    draw_progress(get_value<details::ProgressBarOption::stream>(), false);
+                }
+                return;
+            }
+        }
+
+        if (renderer_mode_.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        if (redraw_throttle_.try_claim(std::chrono::nanoseconds(min_redraw_interval_ns_.load(std::memory_order_relaxed)), now()))
+        {
+            // Skip the frame rather than wait for a render already in progress
+            std::unique_lock<std::mutex> lock{mutex_, std::try_to_lock};
+            if (lock.owns_lock())
+            {
+                draw_progress(get_value<details::ProgressBarOption::stream>(), false);
+            }
+        }
+    }
+
+    bool ProgressBar::reached_end(size_t progress) const
+    {
+        if (decremental_.load(std::memory_order_relaxed))
+        {
+            return progress <= min_progress_.load(std::memory_order_relaxed);
+        }
+        return progress >= max_progress_.load(std::memory_order_relaxed);
     }
 
     void ProgressBar::save_start_time()
     {
-        auto &show_elapsed_time = get_value<details::ProgressBarOption::show_elapsed_time>();
         auto &saved_start_time = get_value<details::ProgressBarOption::saved_start_time>();
-        auto &show_remaining_time = get_value<details::ProgressBarOption::show_remaining_time>();
-        if ((show_elapsed_time || show_remaining_time) && !saved_start_time)
+        if (!saved_start_time)
         {
-            start_time_point_ = std::chrono::high_resolution_clock::now();
+            start_time_ = now();
             saved_start_time = true;
         }
+        start_time_pending_.store(false, std::memory_order_relaxed);
+    }
+
+    void ProgressBar::update_layout()
+    {
+        style_.set(get_value<details::ProgressBarOption::foreground_color>(), get_value<details::ProgressBarOption::font_styles>());
+        prefix_width_ = unicode::display_width(get_value<details::ProgressBarOption::prefix_text>());
+        postfix_text_width_ = unicode::display_width(get_value<details::ProgressBarOption::postfix_text>());
+        scale_writer_.set_style(get_value<details::ProgressBarOption::bar_width>(),
+                                get_value<details::ProgressBarOption::fill>(),
+                                get_value<details::ProgressBarOption::lead>(),
+                                get_value<details::ProgressBarOption::remainder>());
+        layout_dirty_ = false;
+    }
+
+    size_t ProgressBar::append_prefix_text(std::string &out)
+    {
+        size_t indent_width = 0;
+        if (multi_progress_mode_)
+        {
+            // Children of an aggregate are drawn as its subtree
+            size_t depth = 0;
+            for (auto *parent = parent_.load(std::memory_order_acquire); parent; parent = parent->parent_.load(std::memory_order_acquire))
+            {
+                ++depth;
+            }
+            if (depth > 0)
+            {
+                indent_width = 2 * depth;
+                out.append(indent_width - 2, ' ');
+                out.append("└ ");
+            }
+        }
+        out.append(get_value<details::ProgressBarOption::prefix_text>());
+        return indent_width + prefix_width_;
+    }
+
+    double ProgressBar::exact_percentage(size_t progress) const
+    {
+        const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
+        if (max_progress == 0)
+        {
+            // Nothing to do is all done
+            return 100.0;
+        }
+        return double(progress) / double(max_progress) * 100.0;
     }
 
-    std::pair<std::string, size_t> ProgressBar::get_prefix_text()
+    size_t ProgressBar::percentage(size_t progress) const
     {
-        std::stringstream os;
-        os << get_value<details::ProgressBarOption::prefix_text>();
-        const auto result = os.str();
-        const auto result_size = unicode::display_width(result);
-        return {result, result_size};
+        return std::min(static_cast<size_t>(exact_percentage(progress)), size_t(100));
     }
 
-    std::pair<std::string, size_t> ProgressBar::get_postfix_text()
+    size_t ProgressBar::done_work(size_t progress) const
     {
-        std::stringstream os;
+        const auto min_progress = get_value<details::ProgressBarOption::min_progress>();
         const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
+        const auto clamped = std::min(std::max(progress, min_progress), max_progress);
+        return get_value<details::ProgressBarOption::progress_type>() == ProgressType::decremental ? max_progress - clamped : clamped - min_progress;
+    }
+
+    void ProgressBar::update_elapsed(size_t progress)
+    {
+        if (state_.load(std::memory_order_acquire) == State::completed)
+        {
+            return;
+        }
+        elapsed_ = now() - start_time_;
+        if (get_value<details::ProgressBarOption::saved_start_time>())
+        {
+            rate_.sample(double(done_work(progress)), elapsed_);
+        }
+    }
+
+    std::chrono::nanoseconds ProgressBar::remaining_time(size_t progress) const
+    {
+        const auto total = get_value<details::ProgressBarOption::max_progress>() - get_value<details::ProgressBarOption::min_progress>();
+        const auto done = done_work(progress);
+        if (done >= total)
+        {
+            return std::chrono::nanoseconds::zero();
+        }
+        if (rate_.has_rate() && rate_.rate() > 0)
+        {
+            // Based on the recent throughput, so a slow start or a stall does not skew it for long
+            return rate_.remaining(double(total - done));
+        }
+        if (done == 0)
+        {
+            return std::chrono::nanoseconds::zero();
+        }
+        return std::chrono::nanoseconds(static_cast<long long>(double(elapsed_.count()) * double(total - done) / double(done)));
+    }
+
+    details::FrameKey ProgressBar::frame_key(size_t progress, size_t terminal_width) const
+    {
+        details::FrameKey key;
+        key.position = scale_writer_.position(exact_percentage(progress));
+        if (get_value<details::ProgressBarOption::show_percentage>())
+        {
+            key.percent = percentage(progress);
+        }
+        if (get_value<details::ProgressBarOption::saved_start_time>())
+        {
+            if (get_value<details::ProgressBarOption::show_elapsed_time>())
+            {
+                key.elapsed_seconds = std::chrono::duration_cast<std::chrono::seconds>(elapsed_).count();
+            }
+            if (get_value<details::ProgressBarOption::show_remaining_time>())
+            {
+                key.remaining_seconds = std::chrono::duration_cast<std::chrono::seconds>(remaining_time(progress)).count();
+            }
+        }
+        if (get_value<details::ProgressBarOption::show_rate>())
+        {
+            const auto rate = details::scale_rate(rate_.rate());
+            key.rate_tenths = rate.tenths;
+            key.rate_prefix = rate.prefix;
+        }
+        key.layout_version = layout_version_;
+        key.terminal_width = terminal_width;
+        return key;
+    }
+
+    size_t ProgressBar::append_postfix_text(std::string &out, size_t progress)
+    {
+        const auto begin = out.size();
 
         if (get_value<details::ProgressBarOption::show_percentage>())
         {
-            os << " " << std::min(static_cast<size_t>(static_cast<float>(progress_) / max_progress * 100), size_t(100)) << "%";
+            out.push_back(' ');
+            details::append_number(out, percentage(progress));
+            out.push_back('%');
         }
 
         auto &saved_start_time = get_value<details::ProgressBarOption::saved_start_time>();
 
         if (get_value<details::ProgressBarOption::show_elapsed_time>())
         {
-            os << " [";
+            out.append(" [");
             if (saved_start_time)
             {
-                details::write_duration(os, elapsed_);
+                elapsed_text_.append(out, elapsed_);
             }
             else
             {
-                os << "00:00s";
+                out.append("00:00s");
             }
         }
 
@@ -153,121 +623,298 @@ namespace indicators
         {
             if (get_value<details::ProgressBarOption::show_elapsed_time>())
             {
-                os << "<";
+                out.push_back('<');
             }
             else
             {
-                os << " [";
+                out.append(" [");
             }
 
             if (saved_start_time)
             {
-                auto eta = std::chrono::nanoseconds(
-                    progress_ > 0
-                        ? static_cast<long long>(std::ceil(float(elapsed_.count()) *
-                                                           max_progress / progress_))
-                        : 0);
-                auto remaining = eta > elapsed_ ? (eta - elapsed_) : (elapsed_ - eta);
-                details::write_duration(os, remaining);
+                remaining_text_.append(out, remaining_time(progress));
             }
             else
             {
-                os << "00:00s";
+                out.append("00:00s");
             }
 
-            os << "]";
+            out.push_back(']');
         }
         else
         {
             if (get_value<details::ProgressBarOption::show_elapsed_time>())
             {
-                os << "]";
+                out.push_back(']');
             }
         }
 
-        os << " " << get_value<details::ProgressBarOption::postfix_text>();
+        if (get_value<details::ProgressBarOption::show_rate>())
+        {
+            out.push_back(' ');
+            details::append_rate(out, details::scale_rate(rate_.rate()), get_value<details::ProgressBarOption::rate_unit>());
+        }
+
+        out.push_back(' ');
 
-        const auto result = os.str();
-        const auto result_size = unicode::display_width(result);
-        return {result, result_size};
+        // Everything generated above is ASCII, so its display width is its length
+        const auto generated_width = out.size() - begin;
+        out.append(get_value<details::ProgressBarOption::postfix_text>());
+        return generated_width + postfix_text_width_;
     }
 
-    void ProgressBar::print_progress(bool from_multi_progress)
+    void ProgressBar::append_json(std::string &out, size_t progress)
+    {
+        const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
+        const auto started = get_value<details::ProgressBarOption::saved_start_time>();
+        const auto elapsed = started ? elapsed_ : std::chrono::nanoseconds::zero();
+
+        details::JsonLine json(out);
+        json.field("name", get_value<details::ProgressBarOption::prefix_text>())
+            .field("progress", progress)
+            .field("max", max_progress)
+            .field("percent", percentage(progress))
+            .field("rate", rate_.rate())
+            .field("elapsed", elapsed)
+            .field("eta", started ? remaining_time(progress) : std::chrono::nanoseconds::zero())
+            .field("completed", state_.load(std::memory_order_acquire) != State::running);
+        if (!get_value<details::ProgressBarOption::postfix_text>().empty())
+        {
+            json.field("postfix", get_value<details::ProgressBarOption::postfix_text>());
+        }
+        json.end();
+    }
+
+    void ProgressBar::publish_status(size_t progress)
+    {
+        if (status_.enabled())
+        {
+            auto &line = status_.buffer();
+            line.clear();
+            append_json(line, progress);
+            status_.publish();
+        }
+    }
+
+    void ProgressBar::collect_metrics(details::BarMetrics &metrics)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        // Read only: syncing a shared bar here would take the change from the row that has to draw it,
+        // and samples taken on the exporter's schedule would skew the rate the bar shows
+        const auto progress = load_progress();
+        auto max_progress = get_value<details::ProgressBarOption::max_progress>();
+        auto completed = is_completed();
+        if (auto *shared = shared_.load(std::memory_order_acquire))
+        {
+            max_progress = shared->max_progress.load(std::memory_order_acquire);
+            const auto at_end = decremental_.load(std::memory_order_relaxed) ? reached_end(progress) : progress >= max_progress;
+            completed = completed || shared->completed.load(std::memory_order_acquire) || at_end;
+        }
+        const auto elapsed = state_.load(std::memory_order_acquire) == State::completed ? elapsed_ : now() - start_time_;
+        const auto started = get_value<details::ProgressBarOption::saved_start_time>();
+        metrics.label = details::metric_label(get_value<details::ProgressBarOption::label>(), get_value<details::ProgressBarOption::prefix_text>());
+        metrics.progress = double(progress);
+        metrics.max_progress = double(max_progress);
+        metrics.rate = rate_.rate();
+        metrics.elapsed = started ? elapsed : std::chrono::nanoseconds::zero();
+        metrics.remaining = started && !completed ? remaining_time(progress) : std::chrono::nanoseconds::zero();
+        metrics.completed = completed;
+    }
+
+    void ProgressBar::print_json(std::ostream &os)
     {
         std::lock_guard<std::mutex> lock{mutex_};
+        sync_shared_state();
+        const auto progress = load_progress();
+        update_elapsed(progress);
+        publish_status(progress);
+        line_.clear();
+        append_json(line_, progress);
+        os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+    }
 
-        auto &os = get_value<details::ProgressBarOption::stream>();
+    size_t ProgressBar::compose_row(size_t progress)
+    {
+        const auto prefix_length = append_prefix_text(line_);
 
-        const auto type = get_value<details::ProgressBarOption::progress_type>();
-        const auto min_progress = get_value<details::ProgressBarOption::min_progress>();
-        const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
-        if (multi_progress_mode_ && !from_multi_progress)
+        line_.append(get_value<details::ProgressBarOption::start>());
+
+        scale_writer_.write(line_, exact_percentage(progress));
+
+        line_.append(get_value<details::ProgressBarOption::end>());
+
+        const auto postfix_length = append_postfix_text(line_, progress);
+
+        // Get length of prefix text and postfix text
+        const auto start_length = get_value<details::ProgressBarOption::start>().size();
+        const auto bar_width = get_value<details::ProgressBarOption::bar_width>();
+        const auto end_length = get_value<details::ProgressBarOption::end>().size();
+        return prefix_length + start_length + bar_width + end_length + postfix_length;
+    }
+
+    void ProgressBar::write_plain_line(std::ostream &os, size_t progress, bool final)
+    {
+        if (!plain_schedule_.due(percentage(progress), final, now()))
         {
-            if ((type == ProgressType::incremental && progress_ >= max_progress) || (type == ProgressType::decremental && progress_ <= min_progress))
-            {
-                get_value<details::ProgressBarOption::completed>() = true;
-            }
             return;
         }
-        auto now = std::chrono::high_resolution_clock::now();
-        if (!get_value<details::ProgressBarOption::completed>())
+        if (layout_dirty_)
         {
-            elapsed_ = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_time_point_);
+            update_layout();
         }
+        line_.clear();
+        compose_row(progress);
+        details::end_plain_line(line_);
+        os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+        os.flush();
+    }
 
-        if (get_value<details::ProgressBarOption::foreground_color>() != Color::unspecified)
+    void ProgressBar::print_plain(std::ostream &os)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        sync_shared_state();
+        const auto progress = load_progress();
+        update_elapsed(progress);
+        publish_status(progress);
+        write_plain_line(os, progress, is_completed());
+    }
+
+    void ProgressBar::print_progress(bool from_multi_progress)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        // An explicit redraw always writes, e.g. after other output moved the cursor
+        drawn_key_ = details::FrameKey{};
+        draw_progress(get_value<details::ProgressBarOption::stream>(), from_multi_progress);
+    }
+
+    void ProgressBar::print_row(details::FrameStream &frame)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (layout_dirty_)
         {
-            details::set_stream_color(os, get_value<details::ProgressBarOption::foreground_color>());
+            update_layout();
         }
+        // The frame tracks the style across rows and writes only what changes
+        frame.set_style(style_);
+        draw_progress(frame, true, frame.terminal_width());
+    }
 
-        for (auto &style : get_value<details::ProgressBarOption::font_styles>())
+    bool ProgressBar::take_row_dirty()
+    {
+        if (row_.take_dirty())
+        {
+            return true;
+        }
+        if (shared_.load(std::memory_order_relaxed))
+        {
+            // Workers in other processes do not tell the container about their updates
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (sync_shared_state())
+            {
+                return true;
+            }
+        }
+        // Elapsed and remaining time move on while the progress does not
+        if (!shows_time_.load(std::memory_order_relaxed) || is_completed())
         {
-            details::set_font_style(os, style);
+            return false;
         }
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (!get_value<details::ProgressBarOption::saved_start_time>())
+        {
+            return false;
+        }
+        const auto elapsed = now() - start_time_;
+        return std::chrono::duration_cast<std::chrono::seconds>(elapsed).count() != row_second_;
+    }
 
-        const auto prefix_pair = get_prefix_text();
-        const auto prefix_text = prefix_pair.first;
-        const auto prefix_length = prefix_pair.second;
-        os << prefix_text;
+    void ProgressBar::draw_progress(std::ostream &os, bool from_multi_progress)
+    {
+        draw_progress(os, from_multi_progress, terminal_size(os).second);
+    }
 
-        os << get_value<details::ProgressBarOption::start>();
+    void ProgressBar::draw_progress(std::ostream &os, bool from_multi_progress, size_t terminal_width)
+    {
+        sync_shared_state();
+        // Relaxed snapshot: concurrent ticks keep going while this frame renders
+        const auto progress = load_progress();
+        if (multi_progress_mode_ && !from_multi_progress)
+        {
+            if (reached_end(progress) || state_.load(std::memory_order_acquire) == State::finishing)
+            {
+                state_.store(State::completed, std::memory_order_release);
+            }
+            return;
+        }
+        update_elapsed(progress);
 
-        details::ProgressScaleWriter writer{
-            os, get_value<details::ProgressBarOption::bar_width>(),
-            get_value<details::ProgressBarOption::fill>(),
-            get_value<details::ProgressBarOption::lead>(),
-            get_value<details::ProgressBarOption::remainder>()};
-        writer.write(double(progress_) / double(max_progress) * 100.0f);
+        if (layout_dirty_)
+        {
+            update_layout();
+        }
 
-        os << get_value<details::ProgressBarOption::end>();
+        const auto finishing = reached_end(progress) || state_.load(std::memory_order_acquire) != State::running;
+        publish_status(progress);
+        if (!from_multi_progress)
+        {
+            // MultiProgress redraws every row after moving the cursor, and the last frame is always written
+            const auto key = frame_key(progress, terminal_width);
+            if (key == drawn_key_ && !finishing)
+            {
+                return;
+            }
+            drawn_key_ = key;
+        }
+        else
+        {
+            row_second_ = std::chrono::duration_cast<std::chrono::seconds>(elapsed_).count();
+        }
 
-        const auto postfix_pair = get_postfix_text();
-        const auto postfix_text = postfix_pair.first;
-        const auto postfix_length = postfix_pair.second;
-        os << postfix_text;
+        if (output_format_ != OutputFormat::terminal && !from_multi_progress)
+        {
+            if (output_format_ == OutputFormat::json_lines)
+            {
+                line_.clear();
+                append_json(line_, progress);
+                os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+                os.flush();
+            }
+            else
+            {
+                write_plain_line(os, progress, finishing);
+            }
+            if (reached_end(progress) || state_.load(std::memory_order_acquire) == State::finishing)
+            {
+                state_.store(State::completed, std::memory_order_release);
+            }
+            return;
+        }
+
+        line_.clear();
+        if (!from_multi_progress)
+        {
+            style_.append(line_, os);
+        }
 
-        // Get length of prefix text and postfix text
-        const auto start_length = get_value<details::ProgressBarOption::start>().size();
-        const auto bar_width = get_value<details::ProgressBarOption::bar_width>();
-        const auto end_length = get_value<details::ProgressBarOption::end>().size();
-        const auto terminal_width = terminal_size().second;
         // prefix + bar_width + postfix should be <= terminal_width
-        const int remaining = terminal_width - (prefix_length + start_length + bar_width + end_length + postfix_length);
+        const int remaining = terminal_width - compose_row(progress);
         if (remaining > 0)
         {
-            os << std::string(remaining, ' ') << "\r";
+            line_.append(remaining, ' ');
+            line_.push_back('\r');
         }
         else if (remaining < 0)
         {
             // Do nothing. Maybe in the future truncate postfix with ...
         }
+        os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
         os.flush();
 
-        if ((type == ProgressType::incremental && progress_ >= max_progress) || (type == ProgressType::decremental && progress_ <= min_progress))
+        if (reached_end(progress) || state_.load(std::memory_order_acquire) == State::finishing)
         {
-            get_value<details::ProgressBarOption::completed>() = true;
+            state_.store(State::completed, std::memory_order_release);
         }
-        if (get_value<details::ProgressBarOption::completed>() && !from_multi_progress) // Don't std::endl if calling from MultiProgress
+        if (is_completed() && !from_multi_progress) // Don't std::endl if calling from MultiProgress
         {
             os << termcolor::reset << std::endl;
         }
@@ -64,22 +64,36 @@ namespace indicators
 
     void ProgressSpinner::set_progress(size_t value)
     {
+        bool completing;
+        std::chrono::nanoseconds min_redraw_interval;
         {
             std::lock_guard<std::mutex> lock{mutex_};
             progress_ = value;
+            completing = progress_ > get_value<details::ProgressBarOption::max_progress>() && !get_value<details::ProgressBarOption::completed>();
+            min_redraw_interval = this->min_redraw_interval();
         }
         save_start_time();
-        print_progress();
+        if (completing || redraw_throttle_.try_claim(min_redraw_interval, now()))
+        {
+            print_progress();
+        }
     }
 
     void ProgressSpinner::tick()
     {
+        bool completing;
+        std::chrono::nanoseconds min_redraw_interval;
         {
             std::lock_guard<std::mutex> lock{mutex_};
             progress_ += 1;
+            completing = progress_ > get_value<details::ProgressBarOption::max_progress>() && !get_value<details::ProgressBarOption::completed>();
+            min_redraw_interval = this->min_redraw_interval();
         }
         save_start_time();
-        print_progress();
+        if (completing || redraw_throttle_.try_claim(min_redraw_interval, now()))
+        {
+            print_progress();
+        }
     }
 
     size_t ProgressSpinner::current()
@@ -94,6 +108,27 @@ namespace indicators
         print_progress();
     }
 
+    void ProgressSpinner::on_option_changed()
+    {
+        output_format_ = details::resolve_output_format(get_value<details::ProgressBarOption::output_format>(), get_value<details::ProgressBarOption::stream>());
+        style_.set(get_value<details::ProgressBarOption::foreground_color>(), get_value<details::ProgressBarOption::font_styles>());
+        clock_.store(get_value<details::ProgressBarOption::clock>() ? get_value<details::ProgressBarOption::clock>() : &Clock::steady(), std::memory_order_release);
+        if (output_format_ == OutputFormat::json_lines)
+        {
+            output_format_ = OutputFormat::plain_lines;
+        }
+    }
+
+    std::chrono::nanoseconds ProgressSpinner::min_redraw_interval() const
+    {
+        const auto min_redraw_interval = get_value<details::ProgressBarOption::min_redraw_interval>();
+        if (output_format_ == OutputFormat::plain_lines)
+        {
+            return details::plain_line_interval(min_redraw_interval);
+        }
+        return min_redraw_interval;
+    }
+
     void ProgressSpinner::save_start_time()
     {
         auto &show_elapsed_time = get_value<details::ProgressBarOption::show_elapsed_time>();
@@ -101,57 +136,42 @@ namespace indicators
         auto &saved_start_time = get_value<details::ProgressBarOption::saved_start_time>();
         if ((show_elapsed_time || show_remaining_time) && !saved_start_time)
         {
-            start_time_point_ = std::chrono::high_resolution_clock::now();
+            start_time_ = now();
             saved_start_time = true;
         }
     }
 
-    void ProgressSpinner::print_progress()
+    void ProgressSpinner::compose_row(std::chrono::nanoseconds elapsed)
     {
-        std::lock_guard<std::mutex> lock{mutex_};
-
-        auto &os = get_value<details::ProgressBarOption::stream>();
-
         const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
-        auto now = std::chrono::high_resolution_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_time_point_);
-
-        if (get_value<details::ProgressBarOption::foreground_color>() != Color::unspecified)
-        {
-            details::set_stream_color(os, get_value<details::ProgressBarOption::foreground_color>());
-        }
-
-        for (auto &style : get_value<details::ProgressBarOption::font_styles>())
-        {
-            details::set_font_style(os, style);
-        }
-
-        os << get_value<details::ProgressBarOption::prefix_text>();
+        line_.append(get_value<details::ProgressBarOption::prefix_text>());
         if (get_value<details::ProgressBarOption::spinner_show>())
         {
-            os << get_value<details::ProgressBarOption::spinner_states>()[index_ % get_value<details::ProgressBarOption::spinner_states>().size()];
+            line_.append(get_value<details::ProgressBarOption::spinner_states>()[index_ % get_value<details::ProgressBarOption::spinner_states>().size()]);
         }
 
         if (get_value<details::ProgressBarOption::show_percentage>())
         {
-            os << " " << std::size_t(progress_ / double(max_progress) * 100) << "%";
+            line_.push_back(' ');
+            details::append_number(line_, std::size_t(progress_ / double(max_progress) * 100));
+            line_.push_back('%');
         }
 
         if (get_value<details::ProgressBarOption::show_elapsed_time>())
         {
-            os << " [";
-            details::write_duration(os, elapsed);
+            line_.append(" [");
+            details::append_duration(line_, elapsed);
         }
 
         if (get_value<details::ProgressBarOption::show_remaining_time>())
         {
             if (get_value<details::ProgressBarOption::show_elapsed_time>())
             {
-                os << "<";
+                line_.push_back('<');
             }
             else
             {
-                os << " [";
+                line_.append(" [");
             }
             auto eta = std::chrono::nanoseconds(
                 progress_ > 0
@@ -159,14 +179,14 @@ namespace indicators
                                                        max_progress / progress_))
                     : 0);
             auto remaining = eta > elapsed ? (eta - elapsed) : (elapsed - eta);
-            details::write_duration(os, remaining);
-            os << "]";
+            details::append_duration(line_, remaining);
+            line_.push_back(']');
         }
         else
         {
             if (get_value<details::ProgressBarOption::show_elapsed_time>())
             {
-                os << "]";
+                line_.push_back(']');
             }
         }
 
@@ -175,7 +195,58 @@ namespace indicators
             get_value<details::ProgressBarOption::max_postfix_text_len>() = 10;
         }
 
-        os << " " << get_value<details::ProgressBarOption::postfix_text>() << std::string(get_value<details::ProgressBarOption::max_postfix_text_len>(), ' ') << "\r";
+        line_.push_back(' ');
+        line_.append(get_value<details::ProgressBarOption::postfix_text>());
+    }
+
+    void ProgressSpinner::collect_metrics(details::BarMetrics &metrics)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
+        metrics.label = details::metric_label(get_value<details::ProgressBarOption::label>(), get_value<details::ProgressBarOption::prefix_text>());
+        metrics.progress = double(std::min(progress_, size_t(max_progress)));
+        metrics.max_progress = double(max_progress);
+        // The start time is only kept while the spinner shows a time
+        metrics.elapsed = get_value<details::ProgressBarOption::saved_start_time>() ? now() - start_time_ : std::chrono::nanoseconds::zero();
+        metrics.completed = get_value<details::ProgressBarOption::completed>();
+        metrics.has_rate = false;
+    }
+
+    void ProgressSpinner::print_progress()
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+
+        auto &os = get_value<details::ProgressBarOption::stream>();
+
+        const auto max_progress = get_value<details::ProgressBarOption::max_progress>();
+        const auto time = now();
+        auto elapsed = time - start_time_;
+
+        if (output_format_ == OutputFormat::plain_lines)
+        {
+            const auto final = progress_ > max_progress || get_value<details::ProgressBarOption::completed>();
+            if (progress_ > max_progress)
+            {
+                get_value<details::ProgressBarOption::completed>() = true;
+            }
+            if (plain_schedule_.due(std::min(std::size_t(progress_ / double(max_progress) * 100), std::size_t(100)), final, time))
+            {
+                line_.clear();
+                compose_row(elapsed);
+                details::end_plain_line(line_);
+                os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+                os.flush();
+            }
+            index_ += 1;
+            return;
+        }
+
+        line_.clear();
+        style_.append(line_, os);
+        compose_row(elapsed);
+        line_.append(get_value<details::ProgressBarOption::max_postfix_text_len>(), ' ');
+        line_.push_back('\r');
+        os.write(line_.data(), static_cast<std::streamsize>(line_.size()));
         os.flush();
         index_ += 1;
         if (progress_ > max_progress)
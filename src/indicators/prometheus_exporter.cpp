@@ -0,0 +1,150 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Prometheus textfile exporter
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/prometheus_exporter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace indicators
+{
+    PrometheusExporter::~PrometheusExporter()
+    {
+        stop();
+    }
+
+    void PrometheusExporter::add(ProgressBar &bar)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        sources_.push_back([&bar](std::vector<details::BarMetrics> &metrics) { collect(bar, metrics); });
+    }
+
+    void PrometheusExporter::add(BlockProgressBar &bar)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        sources_.push_back([&bar](std::vector<details::BarMetrics> &metrics) { collect(bar, metrics); });
+    }
+
+    void PrometheusExporter::add(IndeterminateProgressBar &bar)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        sources_.push_back([&bar](std::vector<details::BarMetrics> &metrics) { collect(bar, metrics); });
+    }
+
+    void PrometheusExporter::add(ProgressSpinner &spinner)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        sources_.push_back([&spinner](std::vector<details::BarMetrics> &metrics) { collect(spinner, metrics); });
+    }
+
+    bool PrometheusExporter::write()
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return write_file();
+    }
+
+    void PrometheusExporter::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        if (thread_.joinable())
+        {
+            thread_.join();
+            write();
+        }
+    }
+
+    void PrometheusExporter::run()
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (!stopping_)
+        {
+            const auto interval = std::max<std::chrono::nanoseconds>(get_value<details::ProgressBarOption::min_redraw_interval>(), std::chrono::milliseconds(1));
+            // A new interval or path is picked up at once
+            if (cv_.wait_for(lock, interval) == std::cv_status::timeout)
+            {
+                write_file();
+            }
+        }
+    }
+
+    bool PrometheusExporter::write_file()
+    {
+        const auto &path = get_value<details::ProgressBarOption::export_path>();
+        if (path.empty())
+        {
+            return false;
+        }
+
+        metrics_.clear();
+        for (auto &source : sources_)
+        {
+            source(metrics_);
+        }
+        details::make_labels_unique(metrics_);
+        text_.clear();
+        details::append_prometheus(text_, metrics_);
+
+        // Without the .prom extension, so the collector skips it while it is written
+        const auto temporary = path + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file.write(text_.data(), static_cast<std::streamsize>(text_.size()));
+            if (!file.flush())
+            {
+                std::remove(temporary.c_str());
+                return false;
+            }
+        }
+#if defined(_WIN32)
+        // rename() does not replace an existing file here, so there is a short window without one
+        std::remove(path.c_str());
+#endif
+        if (std::rename(temporary.c_str(), path.c_str()) != 0)
+        {
+            std::remove(temporary.c_str());
+            return false;
+        }
+        return true;
+    }
+} // namespace indicators
@@ -0,0 +1,270 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Background renderer
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/renderer.h"
+
+#include <algorithm>
+#include <iterator>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace indicators
+{
+    Renderer::~Renderer()
+    {
+        stop();
+    }
+
+    void Renderer::add(ProgressBar &bar)
+    {
+        bar.renderer_mode_ = true;
+        attach({[&bar]() {
+                    std::lock_guard<std::mutex> lock{bar.mutex_};
+                    if (bar.state_ != ProgressBar::State::completed)
+                    {
+                        bar.draw_progress(bar.get_value<details::ProgressBarOption::stream>(), false);
+                    }
+                    return bar.state_ == ProgressBar::State::completed;
+                },
+                [&bar]() {
+                    // Hand the terminal back first, so an update finishing the bar right now draws its own last frame
+                    std::lock_guard<std::mutex> lock{bar.mutex_};
+                    bar.renderer_mode_ = false;
+                    if (bar.state_ != ProgressBar::State::completed)
+                    {
+                        bar.draw_progress(bar.get_value<details::ProgressBarOption::stream>(), false);
+                    }
+                }});
+    }
+
+    void Renderer::attach(Target &&target)
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        if (stopping_)
+        {
+            // Nobody would draw it any more
+            lock.unlock();
+            target.detach();
+            return;
+        }
+        targets_.push_back(std::move(target));
+    }
+
+    void Renderer::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+
+        std::lock_guard<std::mutex> lock{mutex_};
+        for (auto &target : targets_)
+        {
+            target.detach();
+        }
+        targets_.clear();
+    }
+
+    void Renderer::run()
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (!stopping_)
+        {
+            if (settings_changed_)
+            {
+                settings_changed_ = false;
+                apply_thread_settings();
+            }
+
+            // Draw without the lock, so attach() and set_option() never wait for a terminal write
+            std::vector<Target> drawing;
+            drawing.swap(targets_);
+            lock.unlock();
+            draw_targets(drawing);
+            lock.lock();
+            // Keep the drawing order: targets attached during the pass go after the ones already drawn
+            drawing.insert(drawing.end(), std::make_move_iterator(targets_.begin()), std::make_move_iterator(targets_.end()));
+            targets_.swap(drawing);
+
+            const auto interval = std::max<std::chrono::nanoseconds>(get_value<details::ProgressBarOption::min_redraw_interval>(), std::chrono::milliseconds(1));
+            cv_.wait_for(lock, interval, [this] { return stopping_ || settings_changed_; });
+        }
+    }
+
+    void Renderer::draw_targets(std::vector<Target> &targets)
+    {
+        for (auto it = targets.begin(); it != targets.end();)
+        {
+            if (it->draw())
+            {
+                it->detach();
+                it = targets.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void Renderer::apply_thread_settings()
+    {
+        const auto low_priority = get_value<details::ProgressBarOption::low_priority>();
+        const auto &cpus = get_value<details::ProgressBarOption::cpu_affinity>();
+#if defined(_WIN32)
+        SetThreadPriority(GetCurrentThread(), low_priority ? THREAD_PRIORITY_IDLE : THREAD_PRIORITY_NORMAL);
+        DWORD_PTR mask = 0;
+        for (auto cpu : cpus)
+        {
+            if (cpu < sizeof(DWORD_PTR) * 8)
+            {
+                mask |= DWORD_PTR(1) << cpu;
+            }
+        }
+        if (mask != 0)
+        {
+            const auto previous = SetThreadAffinityMask(GetCurrentThread(), mask);
+            if (previous != 0 && !pinned_)
+            {
+                saved_cpus_.clear();
+                for (size_t cpu = 0; cpu < sizeof(DWORD_PTR) * 8; ++cpu)
+                {
+                    if (previous & (DWORD_PTR(1) << cpu))
+                    {
+                        saved_cpus_.push_back(cpu);
+                    }
+                }
+                pinned_ = true;
+            }
+        }
+        else if (pinned_)
+        {
+            DWORD_PTR saved = 0;
+            for (auto cpu : saved_cpus_)
+            {
+                saved |= DWORD_PTR(1) << cpu;
+            }
+            SetThreadAffinityMask(GetCurrentThread(), saved);
+            pinned_ = false;
+        }
+#elif defined(__linux__)
+        sched_param param{};
+        param.sched_priority = 0;
+        const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+        if (low_priority)
+        {
+            // SCHED_IDLE only runs when a CPU has nothing else to do. Fall back to the lowest nice value.
+            if (pthread_setschedparam(pthread_self(), SCHED_IDLE, &param) != 0 && !niced_)
+            {
+                errno = 0;
+                const auto nice = getpriority(PRIO_PROCESS, tid);
+                if (errno == 0 && setpriority(PRIO_PROCESS, tid, 19) == 0)
+                {
+                    saved_nice_ = nice;
+                    niced_ = true;
+                }
+            }
+        }
+        else
+        {
+            pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+            if (niced_)
+            {
+                // Raising the priority again may need CAP_SYS_NICE or a RLIMIT_NICE that allows it
+                setpriority(PRIO_PROCESS, tid, saved_nice_);
+                niced_ = false;
+            }
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (auto cpu : cpus)
+        {
+            if (cpu < CPU_SETSIZE)
+            {
+                CPU_SET(cpu, &set);
+            }
+        }
+        if (CPU_COUNT(&set) != 0)
+        {
+            cpu_set_t previous;
+            CPU_ZERO(&previous);
+            if (!pinned_ && pthread_getaffinity_np(pthread_self(), sizeof(previous), &previous) == 0)
+            {
+                saved_cpus_.clear();
+                for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                {
+                    if (CPU_ISSET(cpu, &previous))
+                    {
+                        saved_cpus_.push_back(cpu);
+                    }
+                }
+                pinned_ = true;
+            }
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+        else if (pinned_)
+        {
+            for (auto cpu : saved_cpus_)
+            {
+                CPU_SET(cpu, &set);
+            }
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            pinned_ = false;
+        }
+#else
+        // Priority and affinity are left to the scheduler on this platform
+        (void)low_priority;
+        (void)cpus;
+#endif
+    }
+} // namespace indicators
\ No newline at end of file
@@ -0,0 +1,220 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Progress shared between processes
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/shared_progress.h"
+
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace indicators
+{
+    struct SharedProgress::Header
+    {
+        std::atomic<bool> ready;
+        size_t slots;
+    };
+
+    namespace
+    {
+        /* The slots follow the header, one cache line in */
+        constexpr size_t slots_offset = alignof(details::SharedBarState);
+
+        size_t mapping_size_for(size_t slots)
+        {
+            return slots_offset + slots * sizeof(details::SharedBarState);
+        }
+    } // namespace
+
+    SharedProgress::SharedProgress(size_t slots)
+    {
+        map_anonymous(slots);
+    }
+
+    SharedProgress::SharedProgress(const std::string &name, size_t slots)
+        : name_(!name.empty() && name[0] == '/' ? name : "/" + name)
+    {
+        map_named(slots);
+    }
+
+    SharedProgress::~SharedProgress()
+    {
+#if !defined(_WIN32)
+        if (header_)
+        {
+            munmap(header_, mapping_size_);
+        }
+        // Forked workers run this destructor too, and must leave the name to the creator
+        if (!name_.empty() && creator_ == details::current_process_id())
+        {
+            shm_unlink(name_.c_str());
+        }
+#endif
+    }
+
+    bool SharedProgress::valid() const
+    {
+        return header_ != nullptr;
+    }
+
+    size_t SharedProgress::size() const
+    {
+        return header_ ? header_->slots : 0;
+    }
+
+    details::SharedBarState *SharedProgress::slot(size_t index) const
+    {
+        if (index >= size())
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<details::SharedBarState *>(reinterpret_cast<char *>(header_) + slots_offset) + index;
+    }
+
+    void SharedProgress::map_anonymous(size_t slots)
+    {
+#if !defined(_WIN32)
+        const auto size = mapping_size_for(slots);
+        void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED)
+        {
+            return;
+        }
+        header_ = static_cast<Header *>(mapping);
+        mapping_size_ = size;
+        initialize(slots);
+#else
+        (void)slots;
+#endif
+    }
+
+    void SharedProgress::map_named(size_t slots)
+    {
+#if !defined(_WIN32)
+        int fd = shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0)
+        {
+            const auto size = mapping_size_for(slots);
+            void *mapping = MAP_FAILED;
+            if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+            {
+                mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+            close(fd);
+            if (mapping == MAP_FAILED)
+            {
+                shm_unlink(name_.c_str());
+                return;
+            }
+            header_ = static_cast<Header *>(mapping);
+            mapping_size_ = size;
+            initialize(slots);
+            return;
+        }
+        if (errno != EEXIST)
+        {
+            return;
+        }
+
+        fd = shm_open(name_.c_str(), O_RDWR, 0);
+        if (fd < 0)
+        {
+            return;
+        }
+        // The creator sizes the segment and then marks it ready, which may not have happened yet
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        struct stat status;
+        while (fstat(fd, &status) == 0 && static_cast<size_t>(status.st_size) < slots_offset &&
+               std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        void *mapping = MAP_FAILED;
+        const auto size = static_cast<size_t>(status.st_size);
+        if (size >= slots_offset)
+        {
+            mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            return;
+        }
+        auto *header = static_cast<Header *>(mapping);
+        while (!header->ready.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (!header->ready.load(std::memory_order_acquire) || mapping_size_for(header->slots) > size)
+        {
+            munmap(mapping, size);
+            return;
+        }
+        header_ = header;
+        mapping_size_ = size;
+#else
+        (void)slots;
+#endif
+    }
+
+    void SharedProgress::initialize(size_t slots)
+    {
+        static_assert(sizeof(Header) <= slots_offset, "The header overlaps the first slot");
+        creator_ = details::current_process_id();
+        // Fresh shared memory is zero filled, which is what a value-initialized state holds as well
+        new (header_) Header();
+        header_->slots = slots;
+        auto *states = reinterpret_cast<details::SharedBarState *>(reinterpret_cast<char *>(header_) + slots_offset);
+        for (size_t i = 0; i < slots; ++i)
+        {
+            new (states + i) details::SharedBarState();
+            states[i].owner.store(creator_, std::memory_order_relaxed);
+        }
+        header_->ready.store(true, std::memory_order_release);
+    }
+} // namespace indicators
@@ -0,0 +1,280 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Status endpoint on a Unix domain socket
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/status_server.h"
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace indicators
+{
+#if !defined(_WIN32)
+    namespace
+    {
+        void write_all(int fd, const std::string &data)
+        {
+            size_t written = 0;
+            while (written < data.size())
+            {
+#if defined(MSG_NOSIGNAL)
+                const auto result = send(fd, data.data() + written, data.size() - written, MSG_NOSIGNAL);
+#else
+                const auto result = write(fd, data.data() + written, data.size() - written);
+#endif
+                if (result < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    // The client went away
+                    return;
+                }
+                written += static_cast<size_t>(result);
+            }
+        }
+
+        /* A socket file that nothing listens on any more, left behind by a run that did not stop */
+        bool is_stale_socket(const sockaddr_un &address)
+        {
+            struct stat status;
+            if (lstat(address.sun_path, &status) != 0 || !S_ISSOCK(status.st_mode))
+            {
+                return false;
+            }
+            const int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (probe < 0)
+            {
+                return false;
+            }
+            int result;
+            do
+            {
+                result = connect(probe, reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+            } while (result != 0 && errno == EINTR);
+            const auto stale = result != 0 && errno == ECONNREFUSED;
+            close(probe);
+            return stale;
+        }
+    } // namespace
+#endif
+
+    StatusServer::~StatusServer()
+    {
+        stop();
+    }
+
+    bool StatusServer::listening() const
+    {
+        return listen_fd_ >= 0;
+    }
+
+    const std::string &StatusServer::path() const
+    {
+        return path_;
+    }
+
+    void StatusServer::add(ProgressBar &bar)
+    {
+        add_indicator(bar);
+    }
+
+    void StatusServer::add(BlockProgressBar &bar)
+    {
+        add_indicator(bar);
+    }
+
+    void StatusServer::add(IndeterminateProgressBar &bar)
+    {
+        add_indicator(bar);
+    }
+
+    void StatusServer::add_cell(details::StatusCell &cell)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        cells_.push_back(&cell);
+    }
+
+    void StatusServer::start()
+    {
+#if !defined(_WIN32)
+        path_ = get_value<details::ProgressBarOption::socket_path>();
+        if (path_.empty())
+        {
+            path_ = "/tmp/indicators-" + std::to_string(getpid()) + ".sock";
+        }
+
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path_.size() >= sizeof(address.sun_path))
+        {
+            return;
+        }
+        std::memcpy(address.sun_path, path_.c_str(), path_.size() + 1);
+
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+        {
+            return;
+        }
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        // A socket left behind by an earlier run of the job would make bind() fail. Anything else
+        // at the path, a live server's socket included, makes this one fail instead.
+        if (is_stale_socket(address))
+        {
+            unlink(path_.c_str());
+        }
+        const auto bound = bind(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0;
+        // Only the user running the job may ask. Nobody can connect before listen(), so there is no window.
+        if (!bound || chmod(path_.c_str(), 0600) != 0 || listen(fd, 8) != 0 || pipe(wake_fds_) != 0)
+        {
+            close(fd);
+            if (bound)
+            {
+                unlink(path_.c_str());
+            }
+            return;
+        }
+        fcntl(wake_fds_[0], F_SETFD, FD_CLOEXEC);
+        fcntl(wake_fds_[1], F_SETFD, FD_CLOEXEC);
+        listen_fd_ = fd;
+        thread_ = std::thread(&StatusServer::run, this);
+#endif
+    }
+
+    void StatusServer::stop()
+    {
+#if !defined(_WIN32)
+        if (thread_.joinable())
+        {
+            const char wake = 0;
+            while (write(wake_fds_[1], &wake, 1) < 0 && errno == EINTR)
+            {
+            }
+            thread_.join();
+        }
+        if (listen_fd_ >= 0)
+        {
+            close(listen_fd_);
+            close(wake_fds_[0]);
+            close(wake_fds_[1]);
+            unlink(path_.c_str());
+            listen_fd_ = -1;
+        }
+#endif
+        // Containers take the server's mutex when rows are pushed, so they are detached without it
+        std::vector<std::function<void()>> detach;
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            detach.swap(detach_);
+            cells_.clear();
+        }
+        for (auto &function : detach)
+        {
+            function();
+        }
+    }
+
+    void StatusServer::run()
+    {
+#if !defined(_WIN32)
+        std::string document;
+        for (;;)
+        {
+            pollfd fds[2] = {{listen_fd_, POLLIN, 0}, {wake_fds_[0], POLLIN, 0}};
+            if (poll(fds, 2, -1) < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return;
+            }
+            if (fds[1].revents != 0)
+            {
+                return;
+            }
+            if (fds[0].revents == 0)
+            {
+                continue;
+            }
+            const int client = accept(listen_fd_, nullptr, nullptr);
+            if (client < 0)
+            {
+                continue;
+            }
+            compose(document);
+            write_all(client, document);
+            close(client);
+        }
+#endif
+    }
+
+    void StatusServer::compose(std::string &out)
+    {
+        out.assign("[");
+        std::string snapshot;
+        std::lock_guard<std::mutex> lock{mutex_};
+        auto first = true;
+        for (const auto *cell : cells_)
+        {
+            // Indicators that have not drawn yet have nothing to report
+            if (!cell->read(snapshot))
+            {
+                continue;
+            }
+            if (!snapshot.empty() && snapshot.back() == '\n')
+            {
+                snapshot.pop_back();
+            }
+            out.append(first ? "\n" : ",\n");
+            out.append(snapshot);
+            first = false;
+        }
+        out.append("\n]\n");
+    }
+} // namespace indicators
@@ -40,26 +40,66 @@
  */
 #include "indicators/termcolor.h"
 
+#include <cstdlib>
+#include <string>
+
 namespace termcolor
 {
+    namespace
+    {
+        /* Values of the capability cached in a stream */
+        const long capability_unknown = 0L;
+        const long capability_color = 1L;
+        const long capability_plain = 2L;
+
+        /* Escape sequences are written without going through the formatted output path */
+        template <size_t N>
+        void write_sequence(std::ostream &stream, const char (&sequence)[N])
+        {
+            stream.write(sequence, N - 1);
+        }
+
+        /* The variable's value, or nullptr when it is unset or empty */
+        const char *env(const char *name)
+        {
+            const char *value = std::getenv(name);
+            return value != nullptr && value[0] != '\0' ? value : nullptr;
+        }
+    } // namespace
+
     std::ostream &colorize(std::ostream &stream)
     {
-        stream.iword(_internal::colorize_index) = 1L;
+        long &flag = stream.iword(_internal::colorize_index());
+        if (flag != 1L)
+        {
+            flag = 1L;
+            invalidate_capability(stream);
+        }
         return stream;
     }
 
     std::ostream &nocolorize(std::ostream &stream)
     {
-        stream.iword(_internal::colorize_index) = 0L;
+        long &flag = stream.iword(_internal::colorize_index());
+        if (flag != 0L)
+        {
+            flag = 0L;
+            invalidate_capability(stream);
+        }
         return stream;
     }
 
+    void invalidate_capability(std::ostream &stream)
+    {
+        stream.iword(_internal::capability_index()) = capability_unknown;
+    }
+
     std::ostream &reset(std::ostream &stream)
     {
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[00m";
+            write_sequence(stream, "\033[00m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream, -1, -1);
 #endif
@@ -72,7 +112,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[1m";
+            write_sequence(stream, "\033[1m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
 #endif
         }
@@ -84,7 +124,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[2m";
+            write_sequence(stream, "\033[2m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
 #endif
         }
@@ -96,7 +136,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[3m";
+            write_sequence(stream, "\033[3m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
 #endif
         }
@@ -108,7 +148,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[4m";
+            write_sequence(stream, "\033[4m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
 #endif
         }
@@ -120,7 +160,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[5m";
+            write_sequence(stream, "\033[5m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
 #endif
         }
@@ -132,7 +172,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[7m";
+            write_sequence(stream, "\033[7m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
 #endif
         }
@@ -144,7 +184,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[8m";
+            write_sequence(stream, "\033[8m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
 #endif
         }
@@ -156,7 +196,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[9m";
+            write_sequence(stream, "\033[9m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
 #endif
         }
@@ -170,7 +210,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[30m";
+            write_sequence(stream, "\033[30m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream,
                                              0 // grey (black)
@@ -185,7 +225,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[31m";
+            write_sequence(stream, "\033[31m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream,
                                              FOREGROUND_RED);
@@ -199,7 +239,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[32m";
+            write_sequence(stream, "\033[32m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream,
                                              FOREGROUND_GREEN);
@@ -213,7 +253,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[33m";
+            write_sequence(stream, "\033[33m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream,
                                              FOREGROUND_GREEN | FOREGROUND_RED);
@@ -227,7 +267,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[34m";
+            write_sequence(stream, "\033[34m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream,
                                              FOREGROUND_BLUE);
@@ -241,7 +281,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[35m";
+            write_sequence(stream, "\033[35m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream,
                                              FOREGROUND_BLUE | FOREGROUND_RED);
@@ -255,7 +295,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[36m";
+            write_sequence(stream, "\033[36m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream,
                                              FOREGROUND_BLUE | FOREGROUND_GREEN);
@@ -269,7 +309,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[37m";
+            write_sequence(stream, "\033[37m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream,
                                              FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED);
@@ -283,7 +323,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[40m";
+            write_sequence(stream, "\033[40m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream, -1,
                                              0 // grey (black)
@@ -298,7 +338,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[41m";
+            write_sequence(stream, "\033[41m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream, -1,
                                              BACKGROUND_RED);
@@ -312,7 +352,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[42m";
+            write_sequence(stream, "\033[42m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream, -1,
                                              BACKGROUND_GREEN);
@@ -326,7 +366,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[43m";
+            write_sequence(stream, "\033[43m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream, -1,
                                              BACKGROUND_GREEN | BACKGROUND_RED);
@@ -340,7 +380,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[44m";
+            write_sequence(stream, "\033[44m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream, -1,
                                              BACKGROUND_BLUE);
@@ -354,7 +394,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[45m";
+            write_sequence(stream, "\033[45m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream, -1,
                                              BACKGROUND_BLUE | BACKGROUND_RED);
@@ -368,7 +408,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[46m";
+            write_sequence(stream, "\033[46m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream, -1,
                                              BACKGROUND_GREEN | BACKGROUND_BLUE);
@@ -382,7 +422,7 @@ namespace termcolor
         if (_internal::is_colorized(stream))
         {
 #if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-            stream << "\033[47m";
+            write_sequence(stream, "\033[47m");
 #elif defined(TERMCOLOR_OS_WINDOWS)
             _internal::win_change_attributes(stream, -1,
                                              BACKGROUND_GREEN | BACKGROUND_BLUE | BACKGROUND_RED);
@@ -403,9 +443,40 @@ namespace termcolor
             return nullptr;
         }
 
+        int colorize_index()
+        {
+            static const int index = std::ios_base::xalloc();
+            return index;
+        }
+
+        int capability_index()
+        {
+            static const int index = std::ios_base::xalloc();
+            return index;
+        }
+
         bool is_colorized(std::ostream &stream)
         {
-            return is_atty(stream) || static_cast<bool>(stream.iword(colorize_index));
+            long &capability = stream.iword(capability_index());
+            if (capability == capability_unknown)
+            {
+                bool colorized;
+                if (stream.iword(colorize_index()))
+                {
+                    colorized = true;
+                }
+                else if (env("NO_COLOR"))
+                {
+                    colorized = false;
+                }
+                else
+                {
+                    const char *force = env("CLICOLOR_FORCE");
+                    colorized = (force && std::string(force) != "0") || is_atty(stream);
+                }
+                capability = colorized ? capability_color : capability_plain;
+            }
+            return capability == capability_color;
         }
 
         bool is_atty(const std::ostream &stream)
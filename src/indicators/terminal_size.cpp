@@ -39,22 +39,204 @@
  */
 #include "indicators/terminal_size.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <signal.h>
+#endif
+
 namespace indicators
 {
+    namespace
+    {
+        constexpr std::pair<size_t, size_t> fallback_size{24, 80};
+
+        struct PinnedSize
+        {
+            const std::ostream *stream;
+            std::pair<size_t, size_t> size;
+        };
+
+        /* Streams with a pinned size. Streams without one only pay for the flag. */
+        std::atomic<bool> any_pinned{false};
+        std::mutex pinned_mutex;
+        std::vector<PinnedSize> pinned_sizes;
+
+        bool pinned_size(const std::ostream &stream, std::pair<size_t, size_t> &size)
+        {
+            if (!any_pinned.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock{pinned_mutex};
+            for (const auto &pinned : pinned_sizes)
+            {
+                if (pinned.stream == &stream)
+                {
+                    size = pinned.size;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+#if defined(_WIN32)
+        DWORD stream_handle(const std::ostream &stream)
+        {
+            if (&stream == &std::cerr || &stream == &std::clog)
+            {
+                return STD_ERROR_HANDLE;
+            }
+            return STD_OUTPUT_HANDLE;
+        }
+
+        std::pair<size_t, size_t> query_size(DWORD handle)
+        {
+            CONSOLE_SCREEN_BUFFER_INFO csbi;
+            if (!GetConsoleScreenBufferInfo(GetStdHandle(handle), &csbi))
+            {
+                return fallback_size;
+            }
+            const int cols = csbi.srWindow.Right - csbi.srWindow.Left + 1;
+            const int rows = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+            return {static_cast<size_t>(rows), static_cast<size_t>(cols)};
+        }
+#else
+        /* Bumped by the SIGWINCH handler. Starts at 1 so that an empty cache entry is always stale. */
+        std::atomic<unsigned> resize_generation{1};
+        struct sigaction previous_sigwinch;
+
+        void on_sigwinch(int signal, siginfo_t *info, void *context)
+        {
+            resize_generation.fetch_add(1, std::memory_order_relaxed);
+            if ((previous_sigwinch.sa_flags & SA_SIGINFO) != 0)
+            {
+                if (previous_sigwinch.sa_sigaction != nullptr)
+                {
+                    previous_sigwinch.sa_sigaction(signal, info, context);
+                }
+            }
+            else if (previous_sigwinch.sa_handler != SIG_DFL && previous_sigwinch.sa_handler != SIG_IGN)
+            {
+                previous_sigwinch.sa_handler(signal);
+            }
+        }
+
+        bool install_sigwinch_handler()
+        {
+            /* Installed with SA_SIGINFO so that either kind of previous handler can be chained */
+            struct sigaction action;
+            sigemptyset(&action.sa_mask);
+            action.sa_flags = SA_RESTART | SA_SIGINFO;
+            action.sa_sigaction = on_sigwinch;
+            return sigaction(SIGWINCH, nullptr, &previous_sigwinch) == 0 && sigaction(SIGWINCH, &action, nullptr) == 0;
+        }
+
+        /* Whether on_sigwinch was still the handler when last checked, and when that was */
+        std::atomic<bool> handler_installed{true};
+        std::atomic<long long> handler_checked_at{0};
+
+        /*
+            An application may install a SIGWINCH handler of its own later on, one that does not
+            chain to ours, and the cache would never go stale again. Checked at most once a second,
+            so a size cached then is trusted for a second at most.
+        */
+        bool handler_still_installed()
+        {
+            const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            auto checked_at = handler_checked_at.load(std::memory_order_relaxed);
+            if (now - checked_at < std::chrono::nanoseconds(std::chrono::seconds(1)).count() ||
+                !handler_checked_at.compare_exchange_strong(checked_at, now, std::memory_order_relaxed))
+            {
+                // Checked recently, or being checked by another thread
+                return handler_installed.load(std::memory_order_relaxed);
+            }
+            struct sigaction current;
+            const auto installed = sigaction(SIGWINCH, nullptr, &current) == 0 && (current.sa_flags & SA_SIGINFO) != 0 &&
+                                   current.sa_sigaction == on_sigwinch;
+            handler_installed.store(installed, std::memory_order_relaxed);
+            return installed;
+        }
+
+        /* One entry per standard output fd, packed as rows << 32 | cols so that a reader never sees a torn size */
+        struct CachedSize
+        {
+            std::atomic<unsigned> generation{0};
+            std::atomic<unsigned long long> size{0};
+        };
+        CachedSize cached_sizes[3];
+
+        int stream_fd(const std::ostream &stream)
+        {
+            if (&stream == &std::cerr || &stream == &std::clog)
+            {
+                return STDERR_FILENO;
+            }
+            return STDOUT_FILENO;
+        }
+
+        std::pair<size_t, size_t> query_size(int fd)
+        {
+            struct winsize size;
+            if (ioctl(fd, TIOCGWINSZ, &size) != 0 || size.ws_col == 0)
+            {
+                return fallback_size;
+            }
+            return {static_cast<size_t>(size.ws_row), static_cast<size_t>(size.ws_col)};
+        }
+
+        std::pair<size_t, size_t> cached_size(int fd)
+        {
+            /* Without the handler nothing would mark the cache stale, so every call asks the terminal */
+            static const bool installed = install_sigwinch_handler();
+            if (!installed || !handler_still_installed())
+            {
+                return query_size(fd);
+            }
+
+            auto &entry = cached_sizes[fd];
+            const auto generation = resize_generation.load(std::memory_order_relaxed);
+            if (entry.generation.load(std::memory_order_acquire) != generation)
+            {
+                const auto size = query_size(fd);
+                entry.size.store(static_cast<unsigned long long>(size.first) << 32 | size.second, std::memory_order_relaxed);
+                entry.generation.store(generation, std::memory_order_release);
+                return size;
+            }
+            const auto size = entry.size.load(std::memory_order_relaxed);
+            return {static_cast<size_t>(size >> 32), static_cast<size_t>(size & 0xffffffffu)};
+        }
+#endif
+    } // namespace
 
     std::pair<size_t, size_t> terminal_size()
     {
+        return terminal_size(std::cout);
+    }
+
+    std::pair<size_t, size_t> terminal_size(const std::ostream &stream)
+    {
+        std::pair<size_t, size_t> size;
+        if (pinned_size(stream, size))
+        {
+            return size;
+        }
 #if defined(_WIN32)
-        CONSOLE_SCREEN_BUFFER_INFO csbi;
-        int cols, rows;
-        GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi);
-        cols = csbi.srWindow.Right - csbi.srWindow.Left + 1;
-        rows = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
-        return {static_cast<size_t>(rows), static_cast<size_t>(cols)};
+        return query_size(stream_handle(stream));
 #else
-        struct winsize size;
-        ioctl(STDOUT_FILENO, TIOCGWINSZ, &size);
-        return {static_cast<size_t>(size.ws_row), static_cast<size_t>(size.ws_col)};
+        return cached_size(stream_fd(stream));
+#endif
+    }
+
+    void invalidate_terminal_size()
+    {
+#if !defined(_WIN32)
+        resize_generation.fetch_add(1, std::memory_order_relaxed);
 #endif
     }
 
@@ -63,4 +245,42 @@ namespace indicators
         return terminal_size().second;
     }
 
+    size_t terminal_width(const std::ostream &stream)
+    {
+        return terminal_size(stream).second;
+    }
+
+    void pin_terminal_size(const std::ostream &stream, size_t rows, size_t cols)
+    {
+        std::lock_guard<std::mutex> lock{pinned_mutex};
+        for (auto &pinned : pinned_sizes)
+        {
+            if (pinned.stream == &stream)
+            {
+                pinned.size = {rows, cols};
+                return;
+            }
+        }
+        pinned_sizes.push_back({&stream, {rows, cols}});
+        any_pinned.store(true, std::memory_order_release);
+    }
+
+    void unpin_terminal_size(const std::ostream &stream)
+    {
+        std::lock_guard<std::mutex> lock{pinned_mutex};
+        pinned_sizes.erase(std::remove_if(pinned_sizes.begin(), pinned_sizes.end(),
+                                          [&stream](const PinnedSize &pinned) { return pinned.stream == &stream; }),
+                           pinned_sizes.end());
+        any_pinned.store(!pinned_sizes.empty(), std::memory_order_release);
+    }
+
+    size_t wrapped_rows(size_t width, size_t terminal_width)
+    {
+        if (width == 0 || terminal_width == 0)
+        {
+            return 1;
+        }
+        return (width + terminal_width - 1) / terminal_width;
+    }
+
 } // namespace indicators
\ No newline at end of file
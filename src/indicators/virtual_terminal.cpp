@@ -0,0 +1,593 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ * 
+ * Copyright (c) 2020, Savely Pototsky (SavaLione)
+ * Copyright (c) 2019, Pranav
+ * Based on: indicators (https://github.com/p-ranav/indicators)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief Virtual terminal
+ * @author SavaLione
+ * @date 16 Oct 2026
+ */
+#include "indicators/virtual_terminal.h"
+
+#include <indicators/display_width.h>
+#include <indicators/termcolor.h>
+#include <indicators/terminal_size.h>
+
+#include <algorithm>
+
+namespace indicators
+{
+    namespace
+    {
+        std::string trim_right(std::string text)
+        {
+            const auto end = text.find_last_not_of(' ');
+            text.erase(end == std::string::npos ? 0 : end + 1);
+            return text;
+        }
+
+        /* Code point of a complete UTF-8 sequence; invalid ones count as U+FFFD */
+        char32_t decode_utf8(const std::string &glyph)
+        {
+            const auto lead = static_cast<unsigned char>(glyph[0]);
+            if (lead < 0x80)
+            {
+                return lead;
+            }
+            char32_t code = lead >= 0xf0 ? lead & 0x07 : lead >= 0xe0 ? lead & 0x0f : lead & 0x1f;
+            for (size_t i = 1; i < glyph.size(); ++i)
+            {
+                code = (code << 6) | (static_cast<unsigned char>(glyph[i]) & 0x3f);
+            }
+            return code;
+        }
+
+        size_t utf8_continuations(unsigned char lead)
+        {
+            if (lead >= 0xf0)
+            {
+                return 3;
+            }
+            if (lead >= 0xe0)
+            {
+                return 2;
+            }
+            return lead >= 0xc0 ? 1 : 0;
+        }
+    } // namespace
+
+    VirtualTerminal::VirtualTerminal(size_t rows, size_t cols)
+        : std::ostream(nullptr), rows_(std::max<size_t>(rows, 1)), cols_(std::max<size_t>(cols, 1)), buffer_(*this),
+          screen_(rows_, std::vector<Cell>(cols_))
+    {
+        rdbuf(&buffer_);
+        *this << termcolor::colorize;
+        pin_terminal_size(*this, rows_, cols_);
+    }
+
+    VirtualTerminal::~VirtualTerminal()
+    {
+        unpin_terminal_size(*this);
+    }
+
+    std::string VirtualTerminal::row(size_t index) const
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        std::string text;
+        for (const auto &cell : screen_.at(index))
+        {
+            text.append(cell.glyph);
+        }
+        return trim_right(std::move(text));
+    }
+
+    std::string VirtualTerminal::screen() const
+    {
+        std::string text;
+        size_t blank_rows = 0;
+        for (size_t i = 0; i < rows_; ++i)
+        {
+            const auto line = row(i);
+            if (line.empty())
+            {
+                ++blank_rows;
+                continue;
+            }
+            text.append(blank_rows, '\n');
+            blank_rows = 0;
+            text.append(line).push_back('\n');
+        }
+        return text;
+    }
+
+    std::string VirtualTerminal::style(size_t row, size_t col) const
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return screen_.at(row).at(col).style;
+    }
+
+    std::vector<std::string> VirtualTerminal::scrollback() const
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return scrollback_;
+    }
+
+    size_t VirtualTerminal::cursor_row() const
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return cursor_row_;
+    }
+
+    size_t VirtualTerminal::cursor_col() const
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return cursor_col_;
+    }
+
+    bool VirtualTerminal::cursor_visible() const
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return cursor_visible_;
+    }
+
+    size_t VirtualTerminal::bytes() const
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return bytes_;
+    }
+
+    std::vector<size_t> VirtualTerminal::frame_bytes() const
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return frame_bytes_;
+    }
+
+    size_t VirtualTerminal::unknown_sequences() const
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return unknown_sequences_;
+    }
+
+    void VirtualTerminal::clear()
+    {
+        flush();
+        std::lock_guard<std::mutex> lock{mutex_};
+        for (auto &line : screen_)
+        {
+            std::fill(line.begin(), line.end(), Cell{});
+        }
+        scrollback_.clear();
+        cursor_row_ = 0;
+        cursor_col_ = 0;
+        wrap_pending_ = false;
+        cursor_visible_ = true;
+        sgr_ = Sgr{};
+        style_.clear();
+        parse_ = Parse::text;
+        csi_.clear();
+        utf8_.clear();
+        utf8_left_ = 0;
+        bytes_ = 0;
+        frame_start_ = 0;
+        frame_bytes_.clear();
+        unknown_sequences_ = 0;
+    }
+
+    void VirtualTerminal::feed(char ch)
+    {
+        ++bytes_;
+        const auto byte = static_cast<unsigned char>(ch);
+        if (parse_ == Parse::escape)
+        {
+            if (ch == '[')
+            {
+                parse_ = Parse::csi;
+                csi_.clear();
+            }
+            else
+            {
+                ++unknown_sequences_;
+                parse_ = Parse::text;
+            }
+            return;
+        }
+        if (parse_ == Parse::csi)
+        {
+            if (byte >= 0x40 && byte <= 0x7e)
+            {
+                parse_ = Parse::text;
+                execute_csi(ch);
+            }
+            else
+            {
+                csi_.push_back(ch);
+            }
+            return;
+        }
+
+        if (utf8_left_ > 0 && (byte & 0xc0) == 0x80)
+        {
+            utf8_.push_back(ch);
+            if (--utf8_left_ == 0)
+            {
+                const int width = unicode::details::mk_wcwidth(decode_utf8(utf8_));
+                put_glyph(utf8_, width < 0 ? 1 : width);
+            }
+            return;
+        }
+        utf8_left_ = 0;
+
+        switch (ch)
+        {
+        case '\033':
+            parse_ = Parse::escape;
+            return;
+        case '\r':
+            cursor_col_ = 0;
+            wrap_pending_ = false;
+            return;
+        case '\n':
+            cursor_col_ = 0;
+            line_feed();
+            return;
+        case '\b':
+            cursor_col_ = cursor_col_ > 0 ? cursor_col_ - 1 : 0;
+            wrap_pending_ = false;
+            return;
+        case '\t':
+            cursor_col_ = std::min(cols_ - 1, (cursor_col_ / 8 + 1) * 8);
+            return;
+        default:
+            break;
+        }
+        if (byte < 0x20 || byte == 0x7f)
+        {
+            return;
+        }
+        if (byte >= 0x80)
+        {
+            utf8_.assign(1, ch);
+            utf8_left_ = utf8_continuations(byte);
+            if (utf8_left_ == 0)
+            {
+                // A stray continuation byte
+                put_glyph("\xef\xbf\xbd", 1);
+            }
+            return;
+        }
+        put_glyph(std::string(1, ch), 1);
+    }
+
+    void VirtualTerminal::put_glyph(const std::string &glyph, int width)
+    {
+        if (width == 0)
+        {
+            // Combining marks join the glyph before them
+            if (cursor_col_ > 0 || wrap_pending_)
+            {
+                auto col = wrap_pending_ ? cursor_col_ : cursor_col_ - 1;
+                while (col > 0 && screen_[cursor_row_][col].glyph.empty())
+                {
+                    --col;
+                }
+                screen_[cursor_row_][col].glyph.append(glyph);
+            }
+            return;
+        }
+        const auto cells = static_cast<size_t>(width);
+        if (wrap_pending_ || cursor_col_ + cells > cols_)
+        {
+            cursor_col_ = 0;
+            wrap_pending_ = false;
+            line_feed();
+        }
+        auto &line = screen_[cursor_row_];
+        line[cursor_col_] = Cell{glyph, style_};
+        for (size_t i = 1; i < cells && cursor_col_ + i < cols_; ++i)
+        {
+            line[cursor_col_ + i] = Cell{std::string(), style_};
+        }
+        cursor_col_ += cells;
+        if (cursor_col_ >= cols_)
+        {
+            cursor_col_ = cols_ - 1;
+            wrap_pending_ = true;
+        }
+    }
+
+    void VirtualTerminal::line_feed()
+    {
+        wrap_pending_ = false;
+        if (cursor_row_ + 1 < rows_)
+        {
+            ++cursor_row_;
+            return;
+        }
+        std::string text;
+        for (const auto &cell : screen_.front())
+        {
+            text.append(cell.glyph);
+        }
+        scrollback_.push_back(trim_right(std::move(text)));
+        screen_.erase(screen_.begin());
+        screen_.emplace_back(cols_);
+    }
+
+    void VirtualTerminal::execute_csi(char final)
+    {
+        const bool is_private = !csi_.empty() && csi_[0] == '?';
+        std::vector<int> params;
+        {
+            int value = -1;
+            for (size_t i = is_private ? 1 : 0; i < csi_.size(); ++i)
+            {
+                const char c = csi_[i];
+                if (c >= '0' && c <= '9')
+                {
+                    value = (value < 0 ? 0 : value * 10) + (c - '0');
+                }
+                else if (c == ';')
+                {
+                    params.push_back(value);
+                    value = -1;
+                }
+                else
+                {
+                    ++unknown_sequences_;
+                    return;
+                }
+            }
+            if (value >= 0 || !params.empty())
+            {
+                params.push_back(value);
+            }
+        }
+        /* First parameter, `fallback` when it is missing or 0 for the counts that treat 0 as 1 */
+        const auto param = [&params](size_t index, int fallback) {
+            return index < params.size() && params[index] >= 0 ? params[index] : fallback;
+        };
+        const auto count = static_cast<size_t>(std::max(param(0, 1), 1));
+
+        if (is_private)
+        {
+            if ((final == 'h' || final == 'l') && param(0, 0) == 25)
+            {
+                cursor_visible_ = final == 'h';
+            }
+            else
+            {
+                ++unknown_sequences_;
+            }
+            return;
+        }
+
+        switch (final)
+        {
+        case 'A':
+            cursor_row_ -= std::min(count, cursor_row_);
+            break;
+        case 'B':
+            cursor_row_ = std::min(cursor_row_ + count, rows_ - 1);
+            break;
+        case 'C':
+            cursor_col_ = std::min(cursor_col_ + count, cols_ - 1);
+            break;
+        case 'D':
+            cursor_col_ -= std::min(count, cursor_col_);
+            break;
+        case 'G':
+            cursor_col_ = std::min(count, cols_) - 1;
+            break;
+        case 'H':
+            cursor_row_ = std::min(static_cast<size_t>(std::max(param(0, 1), 1)), rows_) - 1;
+            cursor_col_ = std::min(static_cast<size_t>(std::max(param(1, 1), 1)), cols_) - 1;
+            break;
+        case 'K':
+            switch (param(0, 0))
+            {
+            case 0:
+                erase(cursor_row_, cursor_col_, cols_);
+                break;
+            case 1:
+                erase(cursor_row_, 0, cursor_col_ + 1);
+                break;
+            default:
+                erase(cursor_row_, 0, cols_);
+                break;
+            }
+            break;
+        case 'J':
+        {
+            const auto mode = param(0, 0);
+            if (mode == 0)
+            {
+                erase(cursor_row_, cursor_col_, cols_);
+            }
+            else
+            {
+                erase(cursor_row_, 0, mode == 1 ? cursor_col_ + 1 : cols_);
+            }
+            for (size_t row = 0; row < rows_; ++row)
+            {
+                if ((mode == 0 && row > cursor_row_) || (mode == 1 && row < cursor_row_) || mode == 2 || mode == 3)
+                {
+                    erase(row, 0, cols_);
+                }
+            }
+            break;
+        }
+        case 'm':
+            apply_sgr(params);
+            return;
+        default:
+            ++unknown_sequences_;
+            return;
+        }
+        wrap_pending_ = false;
+    }
+
+    void VirtualTerminal::apply_sgr(const std::vector<int> &params)
+    {
+        if (params.empty())
+        {
+            sgr_ = Sgr{};
+        }
+        for (size_t i = 0; i < params.size(); ++i)
+        {
+            const auto code = params[i] < 0 ? 0 : params[i];
+            if (code == 0)
+            {
+                sgr_ = Sgr{};
+            }
+            else if (code < 10)
+            {
+                sgr_.attributes[code] = true;
+            }
+            else if (code == 22)
+            {
+                sgr_.attributes[1] = sgr_.attributes[2] = false;
+            }
+            else if (code >= 23 && code <= 29)
+            {
+                sgr_.attributes[code - 20] = false;
+                if (code == 25)
+                {
+                    sgr_.attributes[6] = false;
+                }
+            }
+            else if (code == 38 || code == 48)
+            {
+                // The color follows as 5;<index> or 2;<r>;<g>;<b>
+                const size_t arguments = i + 1 < params.size() ? (params[i + 1] == 5 ? 2 : params[i + 1] == 2 ? 4 : 0) : 0;
+                auto &color = code == 38 ? sgr_.foreground : sgr_.background;
+                color = std::to_string(code);
+                for (size_t j = i + 1; j <= i + arguments && j < params.size(); ++j)
+                {
+                    color.push_back(';');
+                    color.append(std::to_string(params[j] < 0 ? 0 : params[j]));
+                }
+                i += arguments;
+            }
+            else if (code == 39)
+            {
+                sgr_.foreground.clear();
+            }
+            else if (code == 49)
+            {
+                sgr_.background.clear();
+            }
+            else if ((code >= 30 && code <= 37) || (code >= 90 && code <= 97))
+            {
+                sgr_.foreground = std::to_string(code);
+            }
+            else if ((code >= 40 && code <= 47) || (code >= 100 && code <= 107))
+            {
+                sgr_.background = std::to_string(code);
+            }
+            else
+            {
+                ++unknown_sequences_;
+            }
+        }
+
+        style_.clear();
+        const auto append = [this](const std::string &parameter) {
+            if (!style_.empty())
+            {
+                style_.push_back(';');
+            }
+            style_.append(parameter);
+        };
+        for (int attribute = 1; attribute < 10; ++attribute)
+        {
+            if (sgr_.attributes[attribute])
+            {
+                append(std::to_string(attribute));
+            }
+        }
+        if (!sgr_.foreground.empty())
+        {
+            append(sgr_.foreground);
+        }
+        if (!sgr_.background.empty())
+        {
+            append(sgr_.background);
+        }
+    }
+
+    void VirtualTerminal::erase(size_t row, size_t from, size_t to)
+    {
+        auto &line = screen_[row];
+        for (size_t col = from; col < std::min(to, cols_); ++col)
+        {
+            // Erased cells keep the background of the current style, which the screen does not model
+            line[col] = Cell{};
+        }
+    }
+
+    void VirtualTerminal::end_frame()
+    {
+        if (bytes_ > frame_start_)
+        {
+            frame_bytes_.push_back(bytes_ - frame_start_);
+            frame_start_ = bytes_;
+        }
+    }
+
+    VirtualTerminal::Buffer::int_type VirtualTerminal::Buffer::overflow(int_type ch)
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            std::lock_guard<std::mutex> lock{terminal_.mutex_};
+            terminal_.feed(traits_type::to_char_type(ch));
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize VirtualTerminal::Buffer::xsputn(const char *s, std::streamsize n)
+    {
+        std::lock_guard<std::mutex> lock{terminal_.mutex_};
+        for (std::streamsize i = 0; i < n; ++i)
+        {
+            terminal_.feed(s[i]);
+        }
+        return n;
+    }
+
+    int VirtualTerminal::Buffer::sync()
+    {
+        std::lock_guard<std::mutex> lock{terminal_.mutex_};
+        terminal_.end_frame();
+        return 0;
+    }
+} // namespace indicators
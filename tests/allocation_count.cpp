@@ -0,0 +1,186 @@
+#include <indicators/block_progress_bar.h>
+#include <indicators/clock.h>
+#include <indicators/indeterminate_progress_bar.h>
+#include <indicators/progress_bar.h>
+#include <indicators/progress_spinner.h>
+#include <indicators/termcolor.h>
+#include <indicators/terminal_size.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+#include <streambuf>
+
+/*
+    After the first frames, ticking an indicator that redraws on every tick must not
+    allocate: each one composes its frame in a line buffer that keeps its capacity.
+    Counts every operator new during 50 ticks of each indicator and fails on any.
+*/
+
+namespace
+{
+    std::atomic<bool> counting{false};
+    std::atomic<size_t> allocations{0};
+
+    void *allocate(size_t size)
+    {
+        if (counting.load(std::memory_order_relaxed))
+        {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (auto *p = std::malloc(size ? size : 1))
+        {
+            return p;
+        }
+        std::abort();
+    }
+} // namespace
+
+void *operator new(size_t size)
+{
+    return allocate(size);
+}
+
+void *operator new[](size_t size)
+{
+    return allocate(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+    using namespace indicators;
+
+    constexpr int warm_up_ticks = 10;
+    constexpr int counted_ticks = 50;
+
+    /* Swallows what is written, so that the stream itself never allocates. Colorized and sized like an 80x24 terminal. */
+    class NullTerminal : public std::ostream
+    {
+    public:
+        NullTerminal() : std::ostream(nullptr)
+        {
+            rdbuf(&buffer_);
+            *this << termcolor::colorize;
+            pin_terminal_size(*this, 24, 80);
+        }
+
+        ~NullTerminal()
+        {
+            unpin_terminal_size(*this);
+        }
+
+    private:
+        class Buffer : public std::streambuf
+        {
+        protected:
+            int_type overflow(int_type ch) override
+            {
+                return traits_type::not_eof(ch);
+            }
+
+            std::streamsize xsputn(const char *, std::streamsize n) override
+            {
+                return n;
+            }
+        };
+
+        Buffer buffer_;
+    };
+
+    /* Ticks, advancing the clock so that elapsed and remaining time change on every frame, and returns the allocations of the counted ticks */
+    template <typename Indicator>
+    size_t count_allocations(Indicator &indicator, ManualClock &clock)
+    {
+        for (int i = 0; i < warm_up_ticks; ++i)
+        {
+            clock.advance(std::chrono::milliseconds(70));
+            indicator.tick();
+        }
+        allocations.store(0);
+        counting.store(true);
+        for (int i = 0; i < counted_ticks; ++i)
+        {
+            clock.advance(std::chrono::milliseconds(70));
+            indicator.tick();
+        }
+        counting.store(false);
+        return allocations.load();
+    }
+
+    int failures = 0;
+
+    void expect_no_allocations(const char *name, size_t count)
+    {
+        if (count != 0)
+        {
+            std::printf("FAIL %s: %zu allocations in %d ticks\n", name, count, counted_ticks);
+            ++failures;
+        }
+        else
+        {
+            std::printf("ok   %s\n", name);
+        }
+    }
+} // namespace
+
+int main()
+{
+    NullTerminal terminal;
+    {
+        ManualClock clock;
+        ProgressBar bar{option::Stream{terminal}, option::Clock{&clock}, option::PrefixText{"Copying "}, option::PostfixText{"files"},
+                        option::ShowPercentage{true}, option::ShowElapsedTime{true}, option::ShowRemainingTime{true}, option::MaxProgress{1000}};
+        expect_no_allocations("ProgressBar", count_allocations(bar, clock));
+    }
+    {
+        ManualClock clock;
+        BlockProgressBar bar{option::Stream{terminal}, option::Clock{&clock}, option::PrefixText{"Copying "}, option::PostfixText{"files"},
+                             option::ShowPercentage{true}, option::ShowElapsedTime{true}, option::ShowRemainingTime{true}, option::MaxProgress{1000}};
+        expect_no_allocations("BlockProgressBar", count_allocations(bar, clock));
+    }
+    {
+        ManualClock clock;
+        IndeterminateProgressBar bar{option::Stream{terminal}, option::Clock{&clock}, option::PrefixText{"Waiting "}, option::PostfixText{"for the server"}};
+        expect_no_allocations("IndeterminateProgressBar", count_allocations(bar, clock));
+    }
+    {
+        ManualClock clock;
+        ProgressSpinner spinner{option::Stream{terminal}, option::Clock{&clock}, option::PrefixText{"Indexing "}, option::PostfixText{"files"},
+                                option::ShowPercentage{true}, option::ShowElapsedTime{true}, option::ShowRemainingTime{true}, option::MaxProgress{1000}};
+        expect_no_allocations("ProgressSpinner", count_allocations(spinner, clock));
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,194 @@
+#include <indicators/block_progress_bar.h>
+#include <indicators/clock.h>
+#include <indicators/dynamic_progress.h>
+#include <indicators/indeterminate_progress_bar.h>
+#include <indicators/multi_progress.h>
+#include <indicators/progress_bar.h>
+#include <indicators/progress_spinner.h>
+#include <indicators/virtual_terminal.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/*
+    Renders every kind of indicator into a VirtualTerminal with a ManualClock, so
+    that elapsed and remaining time are the same on every run, and checks the
+    exact screen and the bytes each frame cost.
+*/
+
+namespace
+{
+    using namespace indicators;
+    using std::chrono::milliseconds;
+    using std::chrono::seconds;
+
+    int failures = 0;
+
+    void expect(const std::string &name, bool condition, const std::string &detail)
+    {
+        if (!condition)
+        {
+            std::printf("FAIL %s: %s\n", name.c_str(), detail.c_str());
+            ++failures;
+        }
+    }
+
+    std::string join(const std::vector<size_t> &values)
+    {
+        std::string text;
+        for (auto value : values)
+        {
+            text += (text.empty() ? "" : " ") + std::to_string(value);
+        }
+        return text;
+    }
+
+    /* The screen, the bytes of every frame so far and that no escape went unrecognised */
+    void expect_terminal(const std::string &name, const VirtualTerminal &terminal, const std::string &screen, const std::vector<size_t> &frame_bytes)
+    {
+        expect(name, terminal.screen() == screen, "screen\n" + terminal.screen() + "expected\n" + screen);
+        expect(name, terminal.frame_bytes() == frame_bytes, "frame bytes " + join(terminal.frame_bytes()) + ", expected " + join(frame_bytes));
+        expect(name, terminal.unknown_sequences() == 0, std::to_string(terminal.unknown_sequences()) + " unknown escape sequences");
+    }
+
+    void progress_bar()
+    {
+        VirtualTerminal terminal{4, 60};
+        ManualClock clock;
+        ProgressBar bar{option::Stream{terminal}, option::Clock{&clock}, option::BarWidth{20}, option::PrefixText{"Copying "},
+                        option::PostfixText{"files"}, option::ShowPercentage{true}, option::ShowElapsedTime{true},
+                        option::ShowRemainingTime{true}, option::ForegroundColor{Color::green}};
+
+        // The clock starts with the first update
+        bar.set_progress(10);
+        clock.advance(seconds(3));
+        bar.set_progress(25);
+        expect_terminal("ProgressBar at 25%", terminal, "Copying [=====>              ] 25% [00m:03s<00m:15s] files\n", {66, 66});
+        expect("ProgressBar at 25%", terminal.style(0, 0) == "32", "style \"" + terminal.style(0, 0) + "\", expected green");
+        expect("ProgressBar at 25%", terminal.cursor_row() == 0 && terminal.cursor_col() == 0, "cursor not back at the start of the row");
+
+        clock.advance(seconds(9));
+        bar.set_progress(100);
+        expect_terminal("ProgressBar completed", terminal, "Copying [====================] 100% [00m:12s<00m:00s] files\n", {66, 66, 66, 6});
+        expect("ProgressBar completed", terminal.cursor_row() == 1 && terminal.cursor_col() == 0, "cursor not below the bar");
+    }
+
+    void block_progress_bar()
+    {
+        VirtualTerminal terminal{4, 60};
+        ManualClock clock;
+        BlockProgressBar bar{option::Stream{terminal}, option::Clock{&clock}, option::BarWidth{20}, option::PrefixText{"Copying "},
+                             option::ShowPercentage{true}, option::ShowElapsedTime{true}, option::ShowRemainingTime{true}};
+
+        bar.set_progress(10.f);
+        clock.advance(seconds(2));
+        bar.set_progress(33.f);
+        expect_terminal("BlockProgressBar at 33%", terminal, "Copying [██████▌             ] 33% [00m:02s<00m:05s]\n", {65, 75});
+
+        clock.advance(seconds(4));
+        bar.set_progress(100.f);
+        expect_terminal("BlockProgressBar completed", terminal, "Copying [████████████████████] 100% [00m:06s<00m:00s]\n", {65, 75, 101});
+    }
+
+    void indeterminate_progress_bar()
+    {
+        VirtualTerminal terminal{4, 60};
+        ManualClock clock;
+        IndeterminateProgressBar bar{option::Stream{terminal}, option::Clock{&clock}, option::BarWidth{20},
+                                     option::PrefixText{"Waiting "}, option::PostfixText{"server"}};
+
+        for (int i = 0; i < 3; ++i)
+        {
+            clock.advance(milliseconds(100));
+            bar.tick();
+        }
+        expect_terminal("IndeterminateProgressBar after 3 ticks", terminal, "Waiting [...<==>.............] server\n", {61, 61, 61});
+
+        bar.mark_as_completed();
+        expect_terminal("IndeterminateProgressBar completed", terminal, "Waiting [...<==>.............] server\n", {61, 61, 61, 61, 6});
+        expect("IndeterminateProgressBar completed", terminal.cursor_row() == 1, "cursor not below the bar");
+    }
+
+    void progress_spinner()
+    {
+        VirtualTerminal terminal{4, 60};
+        ManualClock clock;
+        ProgressSpinner spinner{option::Stream{terminal}, option::Clock{&clock}, option::PrefixText{"Indexing "}, option::PostfixText{"files"},
+                                option::ShowPercentage{true}, option::ShowElapsedTime{true}, option::ShowRemainingTime{true}};
+
+        spinner.set_progress(20);
+        clock.advance(seconds(2));
+        spinner.set_progress(40);
+        expect_terminal("ProgressSpinner at 40%", terminal, "Indexing ⠙ 40% [00m:02s<00m:03s] files\n", {51, 51});
+
+        clock.advance(seconds(3));
+        spinner.mark_as_completed();
+        expect_terminal("ProgressSpinner completed", terminal, "Indexing ⠹ 40% [00m:05s<00m:07s] files\n", {51, 51, 51, 6});
+    }
+
+    void multi_progress()
+    {
+        VirtualTerminal terminal{6, 60};
+        ManualClock clock;
+        ProgressBar first{option::Clock{&clock}, option::BarWidth{10}, option::PrefixText{"first  "}, option::ShowPercentage{true}};
+        ProgressBar second{option::Clock{&clock}, option::BarWidth{10}, option::PrefixText{"second "}, option::ShowPercentage{true}};
+        MultiProgress<ProgressBar, 2> bars(first, second);
+        bars.set_option(option::Stream{terminal});
+        bars.set_option(option::Clock{&clock});
+
+        bars.set_progress<0>(size_t{50});
+        expect_terminal("MultiProgress first update", terminal, "first  [=====>    ] 50%\nsecond [>         ] 0%\n", {124});
+
+        bars.set_progress<1>(size_t{20});
+        expect_terminal("MultiProgress second update", terminal, "first  [=====>    ] 50%\nsecond [==>       ] 20%\n", {124, 71});
+
+        bars.set_progress<0>(size_t{100});
+        bars.set_progress<1>(size_t{100});
+        expect_terminal("MultiProgress completed", terminal, "first  [==========] 100%\nsecond [==========] 100%\n", {124, 71, 71, 71});
+        expect("MultiProgress completed", terminal.cursor_row() == 2 && terminal.cursor_col() == 0, "cursor not below the bars");
+    }
+
+    void dynamic_progress()
+    {
+        VirtualTerminal terminal{6, 60};
+        ManualClock clock;
+        ProgressBar first{option::Clock{&clock}, option::BarWidth{10}, option::PrefixText{"first  "}, option::ShowPercentage{true}};
+        ProgressBar second{option::Clock{&clock}, option::BarWidth{10}, option::PrefixText{"second "}, option::ShowPercentage{true}};
+        DynamicProgress<ProgressBar> bars(first);
+        bars.set_option(option::Stream{terminal});
+        bars.set_option(option::Clock{&clock});
+
+        bars[0].set_progress(30);
+        expect_terminal("DynamicProgress one bar", terminal, "first  [===>      ] 30%\n", {65});
+
+        bars.push_back(second);
+        bars[1].set_progress(60);
+        expect_terminal("DynamicProgress bar pushed back", terminal, "first  [===>      ] 30%\nsecond [======>   ] 60%\n", {65, 131});
+
+        // Only the row that changed is drawn again
+        bars[0].set_progress(50);
+        expect_terminal("DynamicProgress one row changed", terminal, "first  [=====>    ] 50%\nsecond [======>   ] 60%\n", {65, 131, 71});
+
+        bars[0].set_progress(100);
+        bars[1].set_progress(100);
+        expect_terminal("DynamicProgress completed", terminal, "first  [==========] 100%\nsecond [==========] 100%\n", {65, 131, 71, 131, 131});
+    }
+} // namespace
+
+int main()
+{
+    progress_bar();
+    block_progress_bar();
+    indeterminate_progress_bar();
+    progress_spinner();
+    multi_progress();
+    dynamic_progress();
+    if (failures == 0)
+    {
+        std::printf("ok\n");
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}